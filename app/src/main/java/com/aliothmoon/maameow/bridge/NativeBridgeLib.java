@@ -10,6 +10,11 @@ import dalvik.annotation.optimization.FastNative;
 public class NativeBridgeLib {
     public static boolean LOADED;
 
+    public static final int CAPTURE_FORMAT_RGBA_8888 = 0;
+    public static final int CAPTURE_FORMAT_RGBX_8888 = 1;
+    public static final int CAPTURE_FORMAT_RGB_565 = 2;
+    public static final int CAPTURE_FORMAT_YUV_420_888 = 3;
+
     static {
         try {
             System.loadLibrary("bridge");
@@ -26,11 +31,55 @@ public class NativeBridgeLib {
 
     public static native Surface setupNativeCapturer(int width, int height);
 
+    /**
+     * 指定 AImageReader 格式，取值为 CAPTURE_FORMAT_*；输出仍统一为 BGR
+     */
+    public static native Surface setupNativeCapturer(int width, int height, int format);
+
     public static native void releaseNativeCapturer();
 
+    /**
+     * 为指定显示建立独立的采集会话，帧通过 GetLockedPixelsForDisplay 按 displayId 读取。
+     * 可先以 null surface 创建 VirtualDisplay，再用返回的 Surface 调用 setSurface 接入
+     */
+    public static native Surface setupDisplayCapturer(int displayId, int width, int height, int format);
+
+    public static native void releaseDisplayCapturer(int displayId);
+
+    /**
+     * 登记主采集会话实际对应的显示 id，之后按该 id 调用 GetLockedPixelsForDisplay 读取主会话的帧；
+     * setupNativeCapturer 会清除登记，需在显示创建完成后调用
+     */
+    public static native void setCaptureDisplayId(int displayId);
+
     @FastNative
     public static native void setPreviewSurface(Object surface);
 
+    /**
+     * 预览目标帧率，0 表示仅受 vsync 限制；悬浮窗低功耗模式可设为 2-5
+     */
+    public static native void setPreviewFrameRate(int fps);
+
+    /**
+     * 预览空闲多久后释放 EGL 资源，下一帧到达时重新初始化；0 表示不释放，默认 60 秒
+     */
+    public static native void setPreviewIdleTimeout(int timeoutMs);
+
+    /**
+     * 预览被遮挡或不可见时置为 false，native 侧不再分发和绘制帧
+     */
+    public static native void setPreviewVisible(boolean visible);
+
+    /**
+     * 在预览画面中由 native 渲染触摸标记，MaaCore 的触摸在 DispatchInputMessage 中直接记录
+     */
+    public static native void setPreviewTouchMarkers(boolean enabled);
+
+    /**
+     * 记录非 MaaCore 来源的触摸，action 为 MotionEvent.ACTION_DOWN / ACTION_MOVE / ACTION_UP
+     */
+    public static native void addPreviewTouchMarker(int x, int y, int action);
+
     /**
      * 测试用
      */
@@ -39,4 +88,10 @@ public class NativeBridgeLib {
     @FastNative
     public static native long getFrameCount();
 
+    /**
+     * 当前帧的时间信息，均为 CLOCK_MONOTONIC 纳秒：
+     * [帧序号, 生产者时间戳, 取图时间, 提交时间, 调用时刻]，无帧时前四项为 0
+     */
+    public static native long[] getFrameTimestamps();
+
 }
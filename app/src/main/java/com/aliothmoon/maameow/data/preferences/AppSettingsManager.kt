@@ -49,6 +49,21 @@ class AppSettingsManager(
         fun parseFontSizeScale(raw: String): Int =
             raw.toIntOrNull()?.coerceIn(FONT_SIZE_SCALE_MIN, FONT_SIZE_SCALE_MAX)
                 ?: FONT_SIZE_SCALE_DEFAULT
+
+        /** 后台预览可选帧率，默认与 native 预览一致 */
+        val MONITOR_FRAME_RATES = listOf(2, 5, 10, 15, 30, 60)
+        const val MONITOR_FRAME_RATE_DEFAULT = 60
+
+        fun parseMonitorFrameRate(raw: String): Int =
+            raw.toIntOrNull()?.takeIf { it in MONITOR_FRAME_RATES } ?: MONITOR_FRAME_RATE_DEFAULT
+
+        /** 后台预览无新帧多久（秒）后远端释放 GL 资源，0 表示不释放；默认与 native 预览一致 */
+        val MONITOR_IDLE_RELEASE_SECONDS = listOf(0, 30, 60, 300)
+        const val MONITOR_IDLE_RELEASE_DEFAULT = 60
+
+        fun parseMonitorIdleRelease(raw: String): Int =
+            raw.toIntOrNull()?.takeIf { it in MONITOR_IDLE_RELEASE_SECONDS }
+                ?: MONITOR_IDLE_RELEASE_DEFAULT
     }
 
     val settings: Flow<AppSettings> = with(AppSettingsSchema) { context.dataStore.flow }
@@ -417,6 +432,40 @@ class AppSettingsManager(
         }
     }
 
+    // 后台预览帧率，远端 native 预览按此限速
+    val monitorFrameRate: StateFlow<Int> = settings
+        .map { parseMonitorFrameRate(it.monitorFrameRate) }
+        .distinctUntilChanged()
+        .stateIn(
+            scope, SharingStarted.Eagerly,
+            parseMonitorFrameRate(initialSettings.monitorFrameRate)
+        )
+
+    suspend fun setMonitorFrameRate(fps: Int) {
+        with(AppSettingsSchema) {
+            context.dataStore.edit {
+                it[monitorFrameRate] = parseMonitorFrameRate(fps.toString()).toString()
+            }
+        }
+    }
+
+    // 后台预览空闲释放时长（秒），画面长时间静止时释放远端 GL 资源以节省内存
+    val monitorIdleRelease: StateFlow<Int> = settings
+        .map { parseMonitorIdleRelease(it.monitorIdleRelease) }
+        .distinctUntilChanged()
+        .stateIn(
+            scope, SharingStarted.Eagerly,
+            parseMonitorIdleRelease(initialSettings.monitorIdleRelease)
+        )
+
+    suspend fun setMonitorIdleRelease(seconds: Int) {
+        with(AppSettingsSchema) {
+            context.dataStore.edit {
+                it[monitorIdleRelease] = parseMonitorIdleRelease(seconds.toString()).toString()
+            }
+        }
+    }
+
     // 应用语言
     enum class AppLanguage(val tag: String) {
         // 仅用于兼容旧数据；启动时会被收敛成显式语言。
@@ -52,6 +52,10 @@ data class AppSettings(
 
     @PrefKey(default = "P720") val backgroundResolution: String = "P720",
 
+    @PrefKey(default = "60") val monitorFrameRate: String = "60",
+
+    @PrefKey(default = "60") val monitorIdleRelease: String = "60",
+
     @PrefKey(default = "SYSTEM") val language: String = "SYSTEM",
 
     @PrefKey(default = "") val pendingChangelogVersion: String = "",
@@ -1,9 +1,13 @@
 package com.aliothmoon.maameow.maa;
 
 
+import android.view.Surface;
+
 import com.aliothmoon.maameow.bridge.NativeBridgeLib;
 import com.aliothmoon.maameow.remote.internal.ActivityUtils;
+import com.aliothmoon.maameow.remote.internal.DisplayCaptureManager;
 import com.aliothmoon.maameow.remote.internal.PrimaryDisplayManager;
+import com.aliothmoon.maameow.remote.internal.VirtualDisplayManager;
 import com.aliothmoon.maameow.third.Ln;
 
 import timber.log.Timber;
@@ -48,6 +52,18 @@ public final class DriverClass {
         }
     }
 
+    /**
+     * native 看门狗发现采集卡住并重建 AImageReader 后回调，displayId 为 -1 表示默认采集会话
+     */
+    public static boolean onCaptureSurfaceChanged(int displayId, Surface surface) {
+        Ln.w(TAG + ": onCaptureSurfaceChanged(displayId=" + displayId + ")");
+        if (displayId != -1) {
+            return DisplayCaptureManager.INSTANCE.replaceSurface(displayId, surface);
+        }
+        return VirtualDisplayManager.INSTANCE.replaceSurface(surface)
+                || PrimaryDisplayManager.INSTANCE.replaceSurface(surface);
+    }
+
     public static boolean touchDown(int x, int y, int displayId) {
         Ln.i(TAG + ": touchDown(" + x + ", " + y + ", displayId=" + displayId + ")");
         boolean result = InputControlUtils.down(x, y, displayId);
@@ -85,12 +85,16 @@ import androidx.compose.ui.res.stringResource
 import androidx.compose.ui.text.AnnotatedString
 import androidx.compose.ui.text.font.FontWeight
 import androidx.compose.ui.unit.Dp
+import androidx.compose.ui.unit.IntSize
 import androidx.compose.ui.unit.dp
 import androidx.compose.ui.viewinterop.AndroidView
 import androidx.core.view.WindowCompat
 import androidx.core.view.WindowInsetsCompat
 import androidx.core.view.WindowInsetsControllerCompat
+import androidx.lifecycle.Lifecycle
+import androidx.lifecycle.compose.LocalLifecycleOwner
 import androidx.lifecycle.compose.collectAsStateWithLifecycle
+import androidx.lifecycle.compose.currentStateAsState
 import com.aliothmoon.maameow.R
 import com.aliothmoon.maameow.constant.DefaultDisplayConfig
 import com.aliothmoon.maameow.data.preferences.AppSettingsManager
@@ -121,6 +125,7 @@ import com.aliothmoon.maameow.theme.MaaThemeAlphas
 import com.aliothmoon.maameow.utils.i18n.asString
 import kotlinx.coroutines.delay
 import kotlinx.coroutines.launch
+import kotlin.math.roundToInt
 import org.koin.compose.koinInject
 import timber.log.Timber
 
@@ -142,7 +147,6 @@ fun BackgroundTaskView(
     val maaState by compositionService.state.collectAsStateWithLifecycle()
     val runMode by appSettingsManager.runMode.collectAsStateWithLifecycle()
     val permissionState by permissionManager.state.collectAsStateWithLifecycle()
-    val markers by viewModel.markers.collectAsStateWithLifecycle()
     val displayResolution by compositionService.displayResolution.collectAsStateWithLifecycle()
     val isChainLoaded by viewModel.chainState.isLoaded.collectAsStateWithLifecycle()
     var hasInitialized by rememberSaveable { mutableStateOf(false) }
@@ -230,8 +234,18 @@ fun BackgroundTaskView(
     }
 
 
+    // Activity 退到后台或屏保遮住预览时暂停远端绘制，窗口化与全屏预览共用
+    val lifecycleState by LocalLifecycleOwner.current.lifecycle.currentStateAsState()
+    val isScreenSaverShowing by screenSaverManager.showing.collectAsStateWithLifecycle()
+    val isMonitorVisible =
+        lifecycleState.isAtLeast(Lifecycle.State.STARTED) && !isScreenSaverShowing
+    LaunchedEffect(isMonitorVisible) {
+        viewModel.onMonitorVisibilityChanged(isMonitorVisible)
+    }
+
     var isSurfaceAvailable by remember { mutableStateOf(false) }
     var lastSentSurface by remember { mutableStateOf<Surface?>(null) }
+    var requestedBufferSize by remember { mutableStateOf<IntSize?>(null) }
     val currentResolution by rememberUpdatedState(displayResolution)
 
     val previewContent = remember {
@@ -244,14 +258,20 @@ fun BackgroundTaskView(
                     AndroidView(
                         factory = { ctx ->
                             SurfaceView(ctx).apply {
+                                val surfaceView = this
                                 holder.setFormat(PixelFormat.RGBA_8888)
                                 holder.addCallback(object : SurfaceHolder.Callback {
                                     override fun surfaceCreated(holder: SurfaceHolder) {
                                         isSurfaceAvailable = true
                                         innerScope.launch {
                                             delay(50)
-                                            val res = currentResolution
-                                            holder.setFixedSize(res.width, res.height)
+                                            val size = previewBufferSize(
+                                                currentResolution,
+                                                surfaceView.width,
+                                                surfaceView.height
+                                            )
+                                            requestedBufferSize = size
+                                            holder.setFixedSize(size.width, size.height)
                                         }
                                     }
 
@@ -259,8 +279,8 @@ fun BackgroundTaskView(
                                         holder: SurfaceHolder, format: Int, width: Int, height: Int
                                     ) {
                                         Timber.d("Surface size changed to $width x $height")
-                                        val res = currentResolution
-                                        if (width == res.width && height == res.height) {
+                                        val size = requestedBufferSize
+                                        if (size != null && width == size.width && height == size.height) {
                                             if (lastSentSurface != holder.surface) {
                                                 lastSentSurface = holder.surface
                                                 viewModel.onSurfaceAvailable(holder.surface)
@@ -271,17 +291,27 @@ fun BackgroundTaskView(
                                     override fun surfaceDestroyed(holder: SurfaceHolder) {
                                         isSurfaceAvailable = false
                                         lastSentSurface = null
+                                        requestedBufferSize = null
                                         viewModel.onSurfaceDestroyed()
                                     }
                                 })
+                                // 切换全屏等导致视图尺寸变化时同步调整缓冲区，Surface 不变，native 侧按新尺寸适配
+                                addOnLayoutChangeListener { _, left, top, right, bottom, oldLeft, oldTop, oldRight, oldBottom ->
+                                    val width = right - left
+                                    val height = bottom - top
+                                    if (width == oldRight - oldLeft && height == oldBottom - oldTop) {
+                                        return@addOnLayoutChangeListener
+                                    }
+                                    if (requestedBufferSize == null) return@addOnLayoutChangeListener
+                                    val size = previewBufferSize(currentResolution, width, height)
+                                    if (size != requestedBufferSize) {
+                                        requestedBufferSize = size
+                                        holder.setFixedSize(size.width, size.height)
+                                    }
+                                }
                             }
                         }, modifier = Modifier.fillMaxSize()
                     )
-                    if (markers.isNotEmpty()) TouchPreviewOverlay(
-                        markers = markers,
-                        displayResolution = displayResolution,
-                        modifier = Modifier.fillMaxSize()
-                    )
                 }
             }
         }
@@ -740,6 +770,28 @@ fun BackgroundTaskView(
     }
 }
 
+/**
+ * 预览缓冲区按视图实际像素缩小并保持显示比例，不超过显示分辨率；
+ * 避免小窗口也按完整分辨率分配缓冲区和填充像素
+ */
+private fun previewBufferSize(
+    resolution: DefaultDisplayConfig.Resolution,
+    viewWidth: Int,
+    viewHeight: Int,
+): IntSize {
+    if (viewWidth <= 0 || viewHeight <= 0) {
+        return IntSize(resolution.width, resolution.height)
+    }
+    val scale = minOf(
+        1f,
+        viewWidth / resolution.width.toFloat(),
+        viewHeight / resolution.height.toFloat()
+    )
+    val width = ((resolution.width * scale).roundToInt() and 1.inv()).coerceAtLeast(2)
+    val height = ((resolution.height * scale).roundToInt() and 1.inv()).coerceAtLeast(2)
+    return IntSize(width, height)
+}
+
 private inline fun viewToVirtualDisplay(
     viewX: Float,
     viewY: Float,
@@ -14,6 +14,8 @@ import androidx.compose.foundation.Image
 import androidx.compose.foundation.clickable
 import androidx.compose.foundation.layout.Arrangement
 import androidx.compose.foundation.layout.Column
+import androidx.compose.foundation.layout.ExperimentalLayoutApi
+import androidx.compose.foundation.layout.FlowRow
 import androidx.compose.foundation.layout.PaddingValues
 import androidx.compose.foundation.layout.Row
 import androidx.compose.foundation.layout.Spacer
@@ -128,6 +130,8 @@ fun SettingsView(
     val fontSizeScale by viewModel.fontSizeScale.collectAsStateWithLifecycle()
     val showAchievementSnackbar by viewModel.showAchievementSnackbar.collectAsStateWithLifecycle()
     val backgroundResolution by viewModel.backgroundResolution.collectAsStateWithLifecycle()
+    val monitorFrameRate by viewModel.monitorFrameRate.collectAsStateWithLifecycle()
+    val monitorIdleRelease by viewModel.monitorIdleRelease.collectAsStateWithLifecycle()
     val customBackgroundEnabled by viewModel.customBackgroundEnabled.collectAsStateWithLifecycle()
     val customBackgroundImageAlpha by viewModel.customBackgroundImageAlpha.collectAsStateWithLifecycle()
     val customBackgroundScrim by viewModel.customBackgroundScrim.collectAsStateWithLifecycle()
@@ -587,6 +591,18 @@ fun SettingsView(
                         onPreferenceSelected = { viewModel.setBackgroundResolution(it) }
                     )
                     ListItemDivider()
+                    SettingMonitorFrameRateItem(
+                        contentColor = contentColor,
+                        selectedFrameRate = monitorFrameRate,
+                        onFrameRateSelected = { viewModel.setMonitorFrameRate(it) }
+                    )
+                    ListItemDivider()
+                    SettingMonitorIdleReleaseItem(
+                        contentColor = contentColor,
+                        selectedSeconds = monitorIdleRelease,
+                        onSecondsSelected = { viewModel.setMonitorIdleRelease(it) }
+                    )
+                    ListItemDivider()
                     SettingSwitchItem(
                         title = stringResource(R.string.settings_skip_shizuku_check),
                         contentColor = contentColor,
@@ -1285,6 +1301,123 @@ private fun SettingBackgroundResolutionItem(
     }
 }
 
+@OptIn(ExperimentalLayoutApi::class)
+@Composable
+private fun SettingMonitorFrameRateItem(
+    contentColor: Color,
+    selectedFrameRate: Int,
+    onFrameRateSelected: (Int) -> Unit
+) {
+    // 选项较多，放在标题下方换行排列
+    Column(
+        modifier = Modifier
+            .fillMaxWidth()
+            .padding(vertical = MaaDesignTokens.Spacing.listItemVertical),
+        verticalArrangement = Arrangement.spacedBy(MaaDesignTokens.Spacing.rowTitleGap)
+    ) {
+        Text(
+            text = stringResource(R.string.settings_monitor_frame_rate_title),
+            style = MaterialTheme.typography.bodyLarge,
+            color = contentColor
+        )
+        Text(
+            text = stringResource(R.string.settings_monitor_frame_rate_desc),
+            style = MaterialTheme.typography.bodySmall,
+            color = contentColor.copy(alpha = 0.7f)
+        )
+        FlowRow(
+            modifier = Modifier.fillMaxWidth(),
+            horizontalArrangement = Arrangement.spacedBy(8.dp)
+        ) {
+            AppSettingsManager.MONITOR_FRAME_RATES.forEach { fps ->
+                Row(
+                    verticalAlignment = Alignment.CenterVertically,
+                    modifier = Modifier
+                        .clip(RoundedCornerShape(8.dp))
+                        .selectable(
+                            selected = fps == selectedFrameRate,
+                            onClick = { onFrameRateSelected(fps) },
+                            role = Role.RadioButton
+                        )
+                ) {
+                    RadioButton(
+                        selected = fps == selectedFrameRate,
+                        onClick = null
+                    )
+                    Spacer(modifier = Modifier.width(2.dp))
+                    Text(
+                        text = fps.toString(),
+                        style = MaterialTheme.typography.bodyMedium,
+                        color = contentColor
+                    )
+                }
+            }
+        }
+    }
+}
+
+@OptIn(ExperimentalLayoutApi::class)
+@Composable
+private fun SettingMonitorIdleReleaseItem(
+    contentColor: Color,
+    selectedSeconds: Int,
+    onSecondsSelected: (Int) -> Unit
+) {
+    Column(
+        modifier = Modifier
+            .fillMaxWidth()
+            .padding(vertical = MaaDesignTokens.Spacing.listItemVertical),
+        verticalArrangement = Arrangement.spacedBy(MaaDesignTokens.Spacing.rowTitleGap)
+    ) {
+        Text(
+            text = stringResource(R.string.settings_monitor_idle_release_title),
+            style = MaterialTheme.typography.bodyLarge,
+            color = contentColor
+        )
+        Text(
+            text = stringResource(R.string.settings_monitor_idle_release_desc),
+            style = MaterialTheme.typography.bodySmall,
+            color = contentColor.copy(alpha = 0.7f)
+        )
+        FlowRow(
+            modifier = Modifier.fillMaxWidth(),
+            horizontalArrangement = Arrangement.spacedBy(8.dp)
+        ) {
+            AppSettingsManager.MONITOR_IDLE_RELEASE_SECONDS.forEach { seconds ->
+                val label = when {
+                    seconds == 0 -> stringResource(R.string.settings_monitor_idle_release_off)
+                    seconds % 60 == 0 -> stringResource(
+                        R.string.settings_monitor_idle_release_minutes, seconds / 60
+                    )
+
+                    else -> stringResource(R.string.settings_monitor_idle_release_seconds, seconds)
+                }
+                Row(
+                    verticalAlignment = Alignment.CenterVertically,
+                    modifier = Modifier
+                        .clip(RoundedCornerShape(8.dp))
+                        .selectable(
+                            selected = seconds == selectedSeconds,
+                            onClick = { onSecondsSelected(seconds) },
+                            role = Role.RadioButton
+                        )
+                ) {
+                    RadioButton(
+                        selected = seconds == selectedSeconds,
+                        onClick = null
+                    )
+                    Spacer(modifier = Modifier.width(2.dp))
+                    Text(
+                        text = label,
+                        style = MaterialTheme.typography.bodyMedium,
+                        color = contentColor
+                    )
+                }
+            }
+        }
+    }
+}
+
 @Composable
 private fun SettingLanguageItem(
     contentColor: Color,
@@ -23,7 +23,6 @@ import com.aliothmoon.maameow.domain.usecase.TaskStartDecision
 import com.aliothmoon.maameow.domain.usecase.TaskStartMode
 import com.aliothmoon.maameow.manager.RemoteServiceManager
 import com.aliothmoon.maameow.presentation.state.BackgroundTaskState
-import com.aliothmoon.maameow.presentation.state.PreviewTouchMarker
 import com.aliothmoon.maameow.presentation.state.UiEffect
 import com.aliothmoon.maameow.presentation.view.panel.PanelDialogConfirmAction
 import com.aliothmoon.maameow.presentation.view.panel.PanelDialogUiState
@@ -80,6 +79,10 @@ class BackgroundTaskViewModel(
 
     private val surfaceRef = AtomicReference<Surface>()
 
+    // 预览所在界面是否可见，服务重连后重新下发
+    @Volatile
+    private var monitorVisible = true
+
     val isGameMuted: StateFlow<Boolean> = gameMuteCoordinator.isMuted
 
     // 调试截图结果（已本地化的提示文案），供 UI 以 Toast 展示
@@ -90,7 +93,6 @@ class BackgroundTaskViewModel(
     val effects: Flow<UiEffect> = _effects.receiveAsFlow()
 
     private val touchPreviewController = TouchPreviewController(viewModelScope)
-    val markers: StateFlow<List<PreviewTouchMarker>> = touchPreviewController.markers
     private var pendingStart: PendingStart? = null
 
     private data class PendingStart(
@@ -103,12 +105,30 @@ class BackgroundTaskViewModel(
         observeServiceState()
         observeTaskEnd()
         observeTouchPreviewToggle()
+        observeMonitorFrameRate()
+        observeMonitorIdleRelease()
     }
 
     private fun observeTouchPreviewToggle() {
         viewModelScope.launch {
             appSettingsManager.showTouchPreview.collect { enabled ->
-                touchPreviewController.onTouchCallbackChange(enabled)
+                touchPreviewController.onTouchPreviewChange(enabled)
+            }
+        }
+    }
+
+    private fun observeMonitorFrameRate() {
+        viewModelScope.launch {
+            appSettingsManager.monitorFrameRate.collect { fps ->
+                applyMonitorFrameRate(fps)
+            }
+        }
+    }
+
+    private fun observeMonitorIdleRelease() {
+        viewModelScope.launch {
+            appSettingsManager.monitorIdleRelease.collect { seconds ->
+                applyMonitorIdleRelease(seconds)
             }
         }
     }
@@ -124,10 +144,6 @@ class BackgroundTaskViewModel(
                             onServiceReconnected(state.service)
                         }
 
-                        is RemoteServiceManager.ServiceState.Error -> {
-                            touchPreviewController.onClear()
-                        }
-
                         else -> Unit
                     }
                 }
@@ -138,8 +154,11 @@ class BackgroundTaskViewModel(
         if (surfaceRef.get() != null) {
             onMonitorSurfaceChanged(srv)
         }
+        applyMonitorFrameRate(appSettingsManager.monitorFrameRate.value, srv)
+        applyMonitorIdleRelease(appSettingsManager.monitorIdleRelease.value, srv)
+        applyMonitorVisible(srv)
         val enabled = appSettingsManager.showTouchPreview.value
-        touchPreviewController.onTouchCallbackChange(enabled)
+        touchPreviewController.onTouchPreviewChange(enabled, srv)
     }
 
     private fun observeTaskEnd() {
@@ -221,6 +240,50 @@ class BackgroundTaskViewModel(
         surface?.release()
     }
 
+    /**
+     * 预览退到后台或被遮挡时调用；不可见期间远端不再分发和绘制帧，Surface 与 EGL 保留，恢复时无需重建
+     */
+    fun onMonitorVisibilityChanged(visible: Boolean) {
+        monitorVisible = visible
+        applyMonitorVisible()
+    }
+
+    private fun applyMonitorVisible(
+        service: RemoteService? = RemoteServiceManager.getInstanceOrNull()
+    ) {
+        val remote = service ?: return
+        val visible = monitorVisible
+        runCatching {
+            remote.setMonitorVisible(visible)
+        }.onFailure {
+            Timber.w(it, "setMonitorVisible failed")
+        }
+    }
+
+    private fun applyMonitorFrameRate(
+        fps: Int,
+        service: RemoteService? = RemoteServiceManager.getInstanceOrNull()
+    ) {
+        val remote = service ?: return
+        runCatching {
+            remote.setMonitorFrameRate(fps)
+        }.onFailure {
+            Timber.w(it, "setMonitorFrameRate failed")
+        }
+    }
+
+    private fun applyMonitorIdleRelease(
+        seconds: Int,
+        service: RemoteService? = RemoteServiceManager.getInstanceOrNull()
+    ) {
+        val remote = service ?: return
+        runCatching {
+            remote.setMonitorIdleTimeout(seconds * 1000)
+        }.onFailure {
+            Timber.w(it, "setMonitorIdleTimeout failed")
+        }
+    }
+
     // ==================== Touch Input ====================
 
     fun onTouchDown(x: Int, y: Int) {
@@ -595,7 +658,6 @@ class BackgroundTaskViewModel(
 
     override fun onCleared() {
         coordinator.cancel()
-        touchPreviewController.onClear()
         super.onCleared()
     }
 }
@@ -245,6 +245,32 @@ class SettingsViewModel(
         }
     }
 
+    val monitorFrameRate: StateFlow<Int> = appSettingsManager.monitorFrameRate
+        .stateIn(
+            viewModelScope,
+            SharingStarted.WhileSubscribed(5000),
+            AppSettingsManager.MONITOR_FRAME_RATE_DEFAULT
+        )
+
+    fun setMonitorFrameRate(fps: Int) {
+        viewModelScope.launch {
+            appSettingsManager.setMonitorFrameRate(fps)
+        }
+    }
+
+    val monitorIdleRelease: StateFlow<Int> = appSettingsManager.monitorIdleRelease
+        .stateIn(
+            viewModelScope,
+            SharingStarted.WhileSubscribed(5000),
+            AppSettingsManager.MONITOR_IDLE_RELEASE_DEFAULT
+        )
+
+    fun setMonitorIdleRelease(seconds: Int) {
+        viewModelScope.launch {
+            appSettingsManager.setMonitorIdleRelease(seconds)
+        }
+    }
+
     val language: StateFlow<AppSettingsManager.AppLanguage> = appSettingsManager.language
         .stateIn(
             viewModelScope,
@@ -2,6 +2,7 @@ package com.aliothmoon.maameow.remote
 
 import android.graphics.Bitmap
 import android.os.Process
+import android.view.MotionEvent
 import android.view.Surface
 import com.aliothmoon.maameow.ITouchEventCallback
 import com.aliothmoon.maameow.MaaCoreService
@@ -12,6 +13,7 @@ import com.aliothmoon.maameow.constant.DisplayMode
 import com.aliothmoon.maameow.maa.InputControlUtils
 import android.content.Intent
 import com.aliothmoon.maameow.remote.internal.ActivityUtils
+import com.aliothmoon.maameow.remote.internal.DisplayCaptureManager
 import com.aliothmoon.maameow.remote.internal.GameAudioMuteController
 import com.aliothmoon.maameow.remote.internal.PermissionGrantHelper
 import com.aliothmoon.maameow.remote.internal.PowerController
@@ -43,6 +45,7 @@ class RemoteServiceImpl : RemoteService.Stub() {
             runCatching {
                 GameAudioMuteController.restoreAll()
                 PowerController.destroy()
+                DisplayCaptureManager.stopAll()
                 ScreenManager.destroy()
                 MaaCoreManager.destroy()
             }.onFailure {
@@ -205,6 +208,35 @@ class RemoteServiceImpl : RemoteService.Stub() {
         NativeBridgeLib.setPreviewSurface(surface)
     }
 
+    override fun setMonitorFrameRate(fps: Int) {
+        Ln.i("$TAG: setMonitorFrameRate($fps)")
+        NativeBridgeLib.setPreviewFrameRate(fps)
+    }
+
+    override fun setMonitorIdleTimeout(timeoutMs: Int) {
+        Ln.i("$TAG: setMonitorIdleTimeout($timeoutMs)")
+        NativeBridgeLib.setPreviewIdleTimeout(timeoutMs)
+    }
+
+    override fun setMonitorVisible(visible: Boolean) {
+        NativeBridgeLib.setPreviewVisible(visible)
+    }
+
+    override fun setMonitorTouchMarkers(enabled: Boolean) {
+        Ln.i("$TAG: setMonitorTouchMarkers($enabled)")
+        NativeBridgeLib.setPreviewTouchMarkers(enabled)
+    }
+
+    override fun startDisplayCapture(displayId: Int): Boolean {
+        Ln.i("$TAG: startDisplayCapture($displayId)")
+        return DisplayCaptureManager.start(displayId)
+    }
+
+    override fun stopDisplayCapture(displayId: Int) {
+        Ln.i("$TAG: stopDisplayCapture($displayId)")
+        DisplayCaptureManager.stop(displayId)
+    }
+
     override fun setTouchCallback(callback: ITouchEventCallback?) {
         Ln.i("$TAG: setTouchCallback(${callback != null})")
         InputControlUtils.setTouchCallback(callback)
@@ -214,6 +246,7 @@ class RemoteServiceImpl : RemoteService.Stub() {
         if (virtualDisplayMode.get() == DisplayMode.PRIMARY) return
         val displayId = VirtualDisplayManager.getDisplayId()
         if (displayId != DefaultDisplayConfig.DISPLAY_NONE) {
+            NativeBridgeLib.addPreviewTouchMarker(x, y, MotionEvent.ACTION_DOWN)
             InputControlUtils.down(x, y, displayId)
         }
     }
@@ -222,6 +255,7 @@ class RemoteServiceImpl : RemoteService.Stub() {
         if (virtualDisplayMode.get() == DisplayMode.PRIMARY) return
         val displayId = VirtualDisplayManager.getDisplayId()
         if (displayId != DefaultDisplayConfig.DISPLAY_NONE) {
+            NativeBridgeLib.addPreviewTouchMarker(x, y, MotionEvent.ACTION_MOVE)
             InputControlUtils.move(x, y, displayId)
         }
     }
@@ -230,6 +264,7 @@ class RemoteServiceImpl : RemoteService.Stub() {
         if (virtualDisplayMode.get() == DisplayMode.PRIMARY) return
         val displayId = VirtualDisplayManager.getDisplayId()
         if (displayId != DefaultDisplayConfig.DISPLAY_NONE) {
+            NativeBridgeLib.addPreviewTouchMarker(x, y, MotionEvent.ACTION_UP)
             InputControlUtils.up(x, y, displayId)
         }
     }
@@ -0,0 +1,74 @@
+package com.aliothmoon.maameow.remote.internal
+
+import android.hardware.display.VirtualDisplay
+import android.view.Surface
+import com.aliothmoon.maameow.bridge.NativeBridgeLib
+import com.aliothmoon.maameow.constant.DefaultDisplayConfig.VD_NAME
+import com.aliothmoon.maameow.third.Ln
+import com.aliothmoon.maameow.third.wrappers.ServiceManager
+import java.util.concurrent.ConcurrentHashMap
+
+/**
+ * 主采集会话之外的附加显示采集：为指定显示建立镜像 VirtualDisplay，
+ * 帧写入 native 侧按 displayId 独立的帧池，通过 GetLockedPixelsForDisplay 读取
+ */
+object DisplayCaptureManager {
+
+    private const val TAG = "DisplayCaptureManager"
+
+    private val sessions = ConcurrentHashMap<Int, VirtualDisplay>()
+
+    @Synchronized
+    fun start(displayId: Int): Boolean {
+        if (sessions.containsKey(displayId)) {
+            return true
+        }
+        val info = runCatching {
+            ServiceManager.getDisplayManager().getDisplayInfo(displayId)
+        }.getOrNull() ?: run {
+            Ln.w("$TAG: display $displayId not found")
+            return false
+        }
+        val width = info.size().width()
+        val height = info.size().height()
+        val surface = NativeBridgeLib.setupDisplayCapturer(
+            displayId, width, height, NativeBridgeLib.CAPTURE_FORMAT_RGBA_8888
+        ) ?: run {
+            Ln.w("$TAG: setupDisplayCapturer failed, displayId=$displayId")
+            return false
+        }
+        return try {
+            sessions[displayId] = ServiceManager.getDisplayManager()
+                .createVirtualDisplay("$VD_NAME-$displayId", width, height, displayId, surface)
+            Ln.i("$TAG: capture started, displayId=$displayId, ${width}x${height}")
+            true
+        } catch (e: Exception) {
+            Ln.e("$TAG: mirror display $displayId failed", e)
+            NativeBridgeLib.releaseDisplayCapturer(displayId)
+            false
+        }
+    }
+
+    /**
+     * native 看门狗重建读取器后在看门狗线程回调；stop 持锁时会等待看门狗退出，这里不能加锁
+     */
+    fun replaceSurface(displayId: Int, surface: Surface): Boolean {
+        val vd = sessions[displayId] ?: return false
+        vd.surface = surface
+        Ln.i("$TAG: surface replaced, displayId=$displayId")
+        return true
+    }
+
+    @Synchronized
+    fun stop(displayId: Int) {
+        val vd = sessions.remove(displayId) ?: return
+        vd.release()
+        NativeBridgeLib.releaseDisplayCapturer(displayId)
+        Ln.i("$TAG: capture stopped, displayId=$displayId")
+    }
+
+    @Synchronized
+    fun stopAll() {
+        sessions.keys.toList().forEach { stop(it) }
+    }
+}
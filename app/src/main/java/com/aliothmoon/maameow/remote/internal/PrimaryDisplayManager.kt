@@ -86,12 +86,28 @@ object PrimaryDisplayManager {
         startInternal()
     }
 
+    fun replaceSurface(surface: Surface): Boolean {
+        if (state.get() != STATE_CAPTURING) {
+            return false
+        }
+        virtualDisplay.get()?.let {
+            it.surface = surface
+            return true
+        }
+        val d = display.get() ?: return false
+        val info = displayInfo.get()
+        val rect = info.size().toRect()
+        setDisplaySurface(d, surface, rect, rect, info.layerStack())
+        return true
+    }
+
     private fun startInternal(): Int {
         val info = displayInfo.get()
         val width = info.size().width()
         val height = info.size().height()
         val surface = NativeBridgeLib.setupNativeCapturer(width, height)
         createVirtualDisplay(surface, info)
+        NativeBridgeLib.setCaptureDisplayId(DISPLAY_ID)
         return DISPLAY_ID
     }
 
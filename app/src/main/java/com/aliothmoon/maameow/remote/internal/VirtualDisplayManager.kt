@@ -99,6 +99,16 @@ object VirtualDisplayManager {
 
     fun getDisplayId(): Int = displayId.get()
 
+    fun replaceSurface(surface: Surface): Boolean {
+        if (state.get() != STATE_CAPTURING) {
+            return false
+        }
+        val vd = virtualDisplay.get() ?: return false
+        vd.surface = surface
+        Ln.i("VirtualDisplayManager surface replaced, displayId=${displayId.get()}")
+        return true
+    }
+
     private fun startInternal(): Int {
         try {
             val cfg = config.get()
@@ -138,6 +148,7 @@ object VirtualDisplayManager {
         virtualDisplay.set(vd)
         val vdId = vd.display.displayId
         displayId.set(vdId)
+        NativeBridgeLib.setCaptureDisplayId(vdId)
 
         val d = vd.display
         Ln.i(
@@ -3,6 +3,7 @@
 #include "bridge_input.h"
 #include "bridge_internal.h"
 #include "bridge_preview.h"
+#include "bridge_preview_overlay.h"
 
 static jstring ping(JNIEnv *env, jclass clazz) {
     (void) clazz;
@@ -19,9 +20,62 @@ static void nativeSetPreviewSurface(JNIEnv *env, jclass clazz, jobject jSurface)
     SetPreviewSurface(env, jSurface);
 }
 
+static void nativeSetPreviewFrameRate(JNIEnv *env, jclass clazz, jint fps) {
+    (void) env;
+    (void) clazz;
+    SetPreviewFrameRate(fps > 0 ? static_cast<uint32_t>(fps) : 0);
+}
+
+static void nativeSetPreviewIdleTimeout(JNIEnv *env, jclass clazz, jint timeoutMs) {
+    (void) env;
+    (void) clazz;
+    SetPreviewIdleTimeout(timeoutMs > 0 ? static_cast<uint32_t>(timeoutMs) : 0);
+}
+
+static void nativeSetPreviewVisible(JNIEnv *env, jclass clazz, jboolean visible) {
+    (void) env;
+    (void) clazz;
+    SetPreviewVisible(visible == JNI_TRUE);
+}
+
+static void nativeSetPreviewTouchMarkers(JNIEnv *env, jclass clazz, jboolean enabled) {
+    (void) env;
+    (void) clazz;
+    SetPreviewTouchMarkersEnabled(enabled == JNI_TRUE);
+}
+
+// action 为 MotionEvent 的 ACTION_DOWN / ACTION_UP / ACTION_MOVE
+static void nativeAddPreviewTouchMarker(JNIEnv *env, jclass clazz, jint x, jint y, jint action) {
+    (void) env;
+    (void) clazz;
+    switch (action) {
+        case 0:
+            PushPreviewTouch(x, y, TOUCH_DOWN);
+            break;
+        case 1:
+            PushPreviewTouch(x, y, TOUCH_UP);
+            break;
+        case 2:
+            PushPreviewTouch(x, y, TOUCH_MOVE);
+            break;
+        default:
+            break;
+    }
+}
+
 static jobject nativeSetupNativeCapturer(JNIEnv *env, jclass clazz, jint width, jint height) {
     (void) clazz;
-    return SetupNativeCapturer(env, width, height);
+    return SetupNativeCapturer(env, width, height, CAPTURE_FORMAT_RGBA_8888);
+}
+
+static jobject nativeSetupNativeCapturerWithFormat(JNIEnv *env, jclass clazz, jint width,
+                                                   jint height, jint format) {
+    (void) clazz;
+    if (!IsValidCaptureFormat(format)) {
+        LOGE("setupNativeCapturer: unsupported format %d", format);
+        return nullptr;
+    }
+    return SetupNativeCapturer(env, width, height, static_cast<CapturePixelFormat>(format));
 }
 
 static void nativeReleaseNativeCapturer(JNIEnv *env, jclass clazz) {
@@ -30,19 +84,57 @@ static void nativeReleaseNativeCapturer(JNIEnv *env, jclass clazz) {
     ReleaseNativeCapturer();
 }
 
+static jobject nativeSetupDisplayCapturer(JNIEnv *env, jclass clazz, jint displayId,
+                                          jint width, jint height, jint format) {
+    (void) clazz;
+    if (!IsValidCaptureFormat(format)) {
+        LOGE("setupDisplayCapturer: unsupported format %d", format);
+        return nullptr;
+    }
+    return SetupDisplayCapturer(env, displayId, width, height,
+                                static_cast<CapturePixelFormat>(format));
+}
+
+static void nativeReleaseDisplayCapturer(JNIEnv *env, jclass clazz, jint displayId) {
+    (void) env;
+    (void) clazz;
+    ReleaseDisplayCapturer(displayId);
+}
+
+static void nativeSetCaptureDisplayId(JNIEnv *env, jclass clazz, jint displayId) {
+    (void) env;
+    (void) clazz;
+    SetDefaultFrameDisplay(displayId);
+}
+
 static jlong nativeGetFrameCount(JNIEnv *env, jclass clazz) {
     (void) env;
     (void) clazz;
     return static_cast<jlong>(GetFrameCount());
 }
 
+static jlongArray nativeGetFrameTimestamps(JNIEnv *env, jclass clazz) {
+    (void) clazz;
+    return CreateFrameTimestampArray(env);
+}
+
 static JNINativeMethod gMethods[] = {
         {"ping",                  "()Ljava/lang/String;",        reinterpret_cast<void *>(ping)},
         {"setupNativeCapturer",   "(II)Landroid/view/Surface;",  reinterpret_cast<void *>(nativeSetupNativeCapturer)},
         {"releaseNativeCapturer", "()V",                         reinterpret_cast<void *>(nativeReleaseNativeCapturer)},
+        {"setupNativeCapturer",   "(III)Landroid/view/Surface;", reinterpret_cast<void *>(nativeSetupNativeCapturerWithFormat)},
+        {"setupDisplayCapturer",  "(IIII)Landroid/view/Surface;", reinterpret_cast<void *>(nativeSetupDisplayCapturer)},
+        {"releaseDisplayCapturer", "(I)V",                       reinterpret_cast<void *>(nativeReleaseDisplayCapturer)},
+        {"setCaptureDisplayId",   "(I)V",                        reinterpret_cast<void *>(nativeSetCaptureDisplayId)},
         {"setPreviewSurface",     "(Ljava/lang/Object;)V",       reinterpret_cast<void *>(nativeSetPreviewSurface)},
+        {"setPreviewFrameRate",   "(I)V",                        reinterpret_cast<void *>(nativeSetPreviewFrameRate)},
+        {"setPreviewIdleTimeout", "(I)V",                        reinterpret_cast<void *>(nativeSetPreviewIdleTimeout)},
+        {"setPreviewVisible",     "(Z)V",                        reinterpret_cast<void *>(nativeSetPreviewVisible)},
+        {"setPreviewTouchMarkers", "(Z)V",                       reinterpret_cast<void *>(nativeSetPreviewTouchMarkers)},
+        {"addPreviewTouchMarker", "(III)V",                      reinterpret_cast<void *>(nativeAddPreviewTouchMarker)},
         {"getFrameBufferBitmap",  "()Landroid/graphics/Bitmap;", reinterpret_cast<void *>(nativeGetFrameBufferBitmap)},
         {"getFrameCount",         "()J",                         reinterpret_cast<void *>(nativeGetFrameCount)},
+        {"getFrameTimestamps",    "()[J",                        reinterpret_cast<void *>(nativeGetFrameTimestamps)},
 };
 
 static constexpr char kNativeBridgeClass[] = "com/aliothmoon/maameow/bridge/NativeBridgeLib";
@@ -21,6 +21,61 @@ struct FrameInfo {
     void *frame_ref;
 };
 
+// 兼容单显示调用方的默认采集会话
+#define FRAME_DISPLAY_DEFAULT (-1)
+
+enum FramePixelFormat {
+    FRAME_FORMAT_BGR888 = 0,
+    FRAME_FORMAT_RGBA8888 = 1,
+    FRAME_FORMAT_GRAY8 = 2
+};
+
+enum LockResult {
+    LOCK_RESULT_OK = 0,
+    LOCK_RESULT_NO_FRAME = 1,
+    LOCK_RESULT_INVALID = -1
+};
+
+// 结构体按 struct_size 做版本区分，新增字段只能追加在末尾
+struct LockOptions {
+    uint32_t struct_size;
+    uint32_t timeout_ms;
+    int64_t min_sequence;
+    FramePixelFormat format;
+    void *dst;
+    uint32_t dst_capacity;
+    int display_id;
+};
+
+struct FrameInfoEx {
+    uint32_t struct_size;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t length;
+    FramePixelFormat format;
+    int64_t sequence;
+    int64_t timestamp_ns;
+    void *data;
+    void *frame_ref;
+    int64_t acquire_time_ns;
+    int64_t commit_time_ns;
+    int64_t lock_time_ns;
+    int64_t fence_wait_ns;
+    // 默认显示的画面分类，见 GetScreenClassification；无匹配或不适用时均为 -1
+    int32_t screen_id;
+    int32_t distance;
+};
+
+// width/height 为 0 时沿用采集分辨率，只给一项时按比例缩放；max_fps 为 0 不限速
+struct FrameSubscription {
+    uint32_t struct_size;
+    FramePixelFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t max_fps;
+};
+
 enum MethodType {
     START_GAME = 1,
     STOP_GAME = 2,
@@ -66,6 +121,81 @@ union ArgUnion {
     KeyArgs key;
 };
 
+// 颜色按 BGR 排列，与帧数据一致
+struct PixelProbe {
+    int x;
+    int y;
+    uint8_t b;
+    uint8_t g;
+    uint8_t r;
+    uint8_t tolerance;
+};
+
+struct RoiRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+#define ROI_STATS_LUMA_BINS 4
+
+// 实际统计区域为对齐到 4 像素格子后的矩形，pixel_count 为其像素数
+struct RoiStats {
+    uint32_t pixel_count;
+    float mean_b;
+    float mean_g;
+    float mean_r;
+    float mean_luma;
+    float var_luma;
+    uint32_t luma_hist[ROI_STATS_LUMA_BINS];
+    uint32_t gray_count;
+    uint32_t red_count;
+    uint32_t green_count;
+    uint32_t blue_count;
+};
+
+// score 为零均值归一化互相关，范围 [-1, 1]；x, y 为匹配位置左上角的帧坐标
+struct TemplateMatchResult {
+    float score;
+    int x;
+    int y;
+};
+
+// distance 为 64 位 dHash 的汉明距离，frame_count 为分类所对应的帧
+struct ScreenClassification {
+    int screen_id;
+    int distance;
+    int64_t frame_count;
+};
+
+#define COLOR_KEY_MAX 8
+
+enum ColorSpace {
+    COLOR_SPACE_BGR = 0,
+    COLOR_SPACE_HSV = 1
+};
+
+// HSV 取 OpenCV 约定：H 0~180，S、V 0~255；上下界均为闭区间。
+// 色相 lower > upper 时跨越 0，如红色取 170~10；其余通道 lower > upper 时注册失败
+struct ColorKeyRange {
+    ColorSpace space;
+    uint8_t lower[3];
+    uint8_t upper[3];
+};
+
+// 每像素 1 位，第 x 个像素位于第 x / 64 个 uint64 的第 x % 64 位，stride 以字节计
+struct ColorKeyMask {
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    const uint64_t *bits;
+    void *frame_ref;
+};
+
+// energy 为区域内相邻两帧的平均亮度差（0~255）
+typedef void (*MotionSettledCallback)(int watch_id, float energy, void *user);
+
 struct MethodParam {
     int display_id;
     MethodType method;
@@ -74,7 +204,143 @@ struct MethodParam {
 
 BRIDGE_API FrameInfo GetLockedPixels(void);
 BRIDGE_API int UnlockPixels(FrameInfo info);
+// display_id 可用默认会话实际采集的显示 id，锁定期间对应帧池不会被其他显示复用
+BRIDGE_API FrameInfo GetLockedPixelsForDisplay(int display_id);
+BRIDGE_API int64_t WaitForDisplayFrame(int display_id, int64_t min_sequence, uint32_t timeout_ms);
+// 返回当前帧序号（>= min_sequence），超时返回 0
+BRIDGE_API int64_t WaitForFrame(int64_t min_sequence, uint32_t timeout_ms);
+// 采集会话的累计计数；fence_wait 为等待合成器栅栏的时间，convert 为转换到 BGR 的时间；
+// images_held 为当前从读取器取出未归还的图像数，即占用的读取器槽位
+struct CaptureStats {
+    uint32_t struct_size;
+    int64_t frames_acquired;
+    int64_t frames_converted;
+    int64_t frames_dropped;
+    int64_t fence_timeouts;
+    int64_t fence_wait_last_ns;
+    int64_t fence_wait_max_ns;
+    int64_t fence_wait_total_ns;
+    int64_t convert_last_ns;
+    int64_t convert_total_ns;
+    int64_t stalls;
+    int64_t reader_rebuilds;
+    int64_t last_frame_age_ns;
+    int32_t stalled;
+    int32_t reader_depth;
+    int64_t reader_full_events;
+    int64_t images_held;
+    int64_t images_held_max;
+};
+
+// 在看门狗线程中调用，回调内不要建立或释放采集会话；rebuilt 非 0 表示已自动重建 AImageReader 并通知 Java 切换 Surface
+typedef void (*CaptureStallCallback)(int display_id, uint32_t stalled_ms, int rebuilt, void *user);
+
+// min_sequence 之前的帧视为未变化，返回 LOCK_RESULT_NO_FRAME；timeout_ms 为等待新帧的上限。
+// BGR888 直接指向帧缓冲，需 UnlockPixelsEx；其他格式写入 options->dst，返回时已解锁
+BRIDGE_API int GetLockedPixelsEx(const LockOptions *options, FrameInfoEx *info);
+BRIDGE_API int UnlockPixelsEx(const FrameInfoEx *info);
+
+// 读取指定显示采集会话的统计，未建立会话时返回 -1
+BRIDGE_API int GetCaptureStats(int display_id, CaptureStats *stats);
+// stall_timeout_ms 为 0 关闭看门狗，默认 750ms、不自动重建。只有生产者已送图却超时未转换出帧，
+// 或重建读取器后仍无帧才算卡住，画面静止不计；重建未能恢复时超时会逐次放宽
+BRIDGE_API void SetCaptureWatchdog(uint32_t stall_timeout_ms, int auto_rebuild,
+                                   CaptureStallCallback callback, void *user);
+// depth 为 0 时从 3 起按读取器占满次数加深（受内存预算限制，只增不减），否则固定为 2~8；
+// 变化后重建读取器
+BRIDGE_API int SetCaptureReaderDepth(int display_id, uint32_t depth);
+
+// 每个订阅者有独立的三槽环形缓冲，所有输出在同一次转换中生成；返回订阅 id
+BRIDGE_API int SubscribeFrames(const FrameSubscription *config);
+// 最多等待 500ms 让读者归还帧，仍未归还返回 -2；此时订阅已移除，帧内存在最后一次解锁时释放
+BRIDGE_API int UnsubscribeFrames(int subscriber_id);
+// 每次成功加锁都必须 UnlockSubscriberFrame 一次，取消订阅后也一样
+BRIDGE_API int GetLockedSubscriberFrame(int subscriber_id, int64_t min_sequence,
+                                        FrameInfoEx *info);
+BRIDGE_API int UnlockSubscriberFrame(const FrameInfoEx *info);
 BRIDGE_API int DispatchInputMessage(MethodParam param);
+// 在预览中叠加绘制的识别区域（帧坐标），最多 16 个，count 为 0 清除；返回实际保存的数量
+BRIDGE_API int SetPreviewRois(const RoiRect *rects, uint32_t count);
+
+enum PreviewBackend {
+    PREVIEW_BACKEND_NONE = 0,
+    PREVIEW_BACKEND_EGL = 1,
+    PREVIEW_BACKEND_CPU = 2
+};
+
+// 预览的累计计数。offered 为采集侧交给预览的帧；replaced 为在信箱中未绘制就被新帧替换的帧，
+// 其中 throttled 为渲染线程正按帧率限制等待时被替换的部分，其余说明渲染跟不上。
+// rendered 为绘制的新帧，redraws 为叠加层动画对最近一帧的重绘，两者都计入 render / swap；
+// latency 为帧的 producer 时间到交换返回，只统计新帧。CPU 回退时 render 含写入窗口，swap 为 0
+struct PreviewStats {
+    uint32_t struct_size;
+    int64_t frames_offered;
+    int64_t frames_replaced;
+    int64_t frames_throttled;
+    int64_t frames_rendered;
+    int64_t redraws;
+    int64_t render_last_ns;
+    int64_t render_max_ns;
+    int64_t render_total_ns;
+    int64_t swap_last_ns;
+    int64_t swap_max_ns;
+    int64_t swap_total_ns;
+    int64_t latency_last_ns;
+    int64_t latency_max_ns;
+    int64_t latency_total_ns;
+    // 渲染后端初始化次数（含空闲释放后的重建）及最近一次从取到帧到首帧呈现的耗时
+    int64_t backend_inits;
+    int64_t first_frame_last_ns;
+    int32_t backend;
+    int32_t visible;
+};
+
+BRIDGE_API int GetPreviewStats(PreviewStats *stats);
+
+// result_mask 需容纳 (count + 31) / 32 个字，第 i 位表示第 i 个探针命中；返回命中数，无帧返回 -1
+BRIDGE_API int ProbePixels(const PixelProbe *probes, uint32_t count, uint32_t *result_mask);
+
+// 积分图默认关闭，开启后从下一帧起生效
+BRIDGE_API int SetRoiStatsEnabled(int enabled);
+// 返回填充的矩形数；当前帧未生成积分图时返回 -1
+BRIDGE_API int QueryRoiStats(const RoiRect *rects, uint32_t count, RoiStats *out);
+
+// 模板为 BGR 像素，注册后按亮度保存；返回模板 id，失败返回 -1
+BRIDGE_API int RegisterTemplate(const uint8_t *bgr, int width, int height, int stride);
+BRIDGE_API int UnregisterTemplate(int template_id);
+// roi 为空时搜索整帧；返回 1 找到，0 区域内无有效位置（含区域小于模板），-1 参数错误或无帧
+BRIDGE_API int MatchTemplate(int template_id, const RoiRect *roi, TemplateMatchResult *result);
+
+// 以当前帧计算区域的 dHash，用于生成参考画面
+BRIDGE_API int ComputeScreenHash(const RoiRect *roi, uint64_t *hash);
+// 同一 screen_id 可注册多个区域，每帧取汉明距离最小的一项
+BRIDGE_API int RegisterScreenHash(int screen_id, const RoiRect *roi, uint64_t hash);
+BRIDGE_API int ClearScreenHashes(void);
+// 按当前索引给出当前帧的分类，注册或清空后画面未变也会更新；无匹配时返回 -1
+BRIDGE_API int GetScreenClassification(ScreenClassification *out);
+
+// 注册后从下一帧起在转换时生成掩码；返回颜色键 id，失败返回 -1
+BRIDGE_API int RegisterColorKey(const ColorKeyRange *range);
+BRIDGE_API int UnregisterColorKey(int key_id);
+// out[i] 为第 i 个矩形内命中的像素数；当前帧无该掩码时返回 -1
+BRIDGE_API int CountColorKeyPixels(int key_id, const RoiRect *rects, uint32_t count,
+                                   uint32_t *out);
+BRIDGE_API int GetLockedColorKeyMask(int key_id, ColorKeyMask *mask);
+BRIDGE_API int UnlockColorKeyMask(ColorKeyMask mask);
+
+// 超过 200ms 无新帧时各区域均视为静止；尚无帧返回 -1
+BRIDGE_API int GetRegionMotion(const RoiRect *rects, uint32_t count, float *energy);
+// 区域运动量从不低于 threshold 变为低于 threshold 时回调一次；新帧在采集线程判断，
+// 超过 200ms 无新帧时在内部定时线程按静止回调，energy 为 0
+BRIDGE_API int AddMotionWatch(const RoiRect *rect, float threshold,
+                              MotionSettledCallback callback, void *user);
+// 返回前会等待其他线程上正在执行的该监视回调结束，之后可以释放 user
+BRIDGE_API int RemoveMotionWatch(int watch_id);
+
+// threshold 为缩略图平均亮度差（0~255）；返回 1 稳定，0 不稳定，-1 尚无帧
+BRIDGE_API int IsScreenStable(uint32_t min_duration_ms, int threshold);
+// 阻塞直到画面稳定（返回 1）或超时（返回 0）
+BRIDGE_API int WaitForStableScreen(uint32_t min_duration_ms, int threshold, uint32_t timeout_ms);
 
 #ifdef __cplusplus
 }
@@ -1,6 +1,7 @@
 #include "bridge_capture.h"
 
 #include "bridge_frame_buffer.h"
+#include "bridge_input.h"
 #include "bridge_preview.h"
 
 #include <android/native_window.h>
@@ -8,101 +9,708 @@
 #include <media/NdkImage.h>
 #include <media/NdkImageReader.h>
 
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 栅栏超过该时长仍未触发则丢弃本帧，避免转换线程被异常的 GPU 任务长期占住
+static constexpr int kFenceTimeoutMs = 500;
+
+static constexpr uint32_t kDefaultStallTimeoutMs = 750;
+static constexpr int kWatchdogTickMs = 100;
+static constexpr int kMaxStallBackoffShift = 4;
+
+// 读取器深度：自适应时从 kAdaptiveMinDepth 起步，窗口内多次占满则加深，不回退，
+// 改深度要重建读取器并切换 Surface，只增不减保证会话内最多重建几次；
+// 加深受内存预算限制，4K RGBA 每个槽位约 37MB
+static constexpr int kMinReaderDepth = 2;
+static constexpr int kMaxReaderDepth = 8;
+static constexpr int kAdaptiveMinDepth = 3;
+static constexpr int64_t kReaderMemoryBudget = 96LL * 1024 * 1024;
+static constexpr int64_t kDepthWindowNs = 1000000000LL;
+static constexpr int kDepthGrowFullEvents = 3;
+
+struct PendingImage {
+    AImage *image = nullptr;
+    int fence = -1;
+    FrameTiming timing{};
+};
+
+struct CaptureCounters {
+    std::atomic<int64_t> frames_acquired{0};
+    std::atomic<int64_t> frames_converted{0};
+    std::atomic<int64_t> frames_dropped{0};
+    std::atomic<int64_t> fence_timeouts{0};
+    std::atomic<int64_t> fence_wait_last_ns{0};
+    std::atomic<int64_t> fence_wait_max_ns{0};
+    std::atomic<int64_t> fence_wait_total_ns{0};
+    std::atomic<int64_t> convert_last_ns{0};
+    std::atomic<int64_t> convert_total_ns{0};
+    std::atomic<int64_t> stalls{0};
+    std::atomic<int64_t> reader_rebuilds{0};
+    std::atomic<int64_t> reader_full_events{0};
+    std::atomic<int64_t> images_held{0};
+    std::atomic<int64_t> images_held_max{0};
+};
+
 struct NativeCapturer {
     AImageReader *reader = nullptr;
     ANativeWindow *window = nullptr;
     AImageReader_ImageListener listener{};
+    AImageReader_BufferRemovedListener buffer_listener{};
+    FramePool *pool = nullptr;
+    int display_id = FRAME_DISPLAY_DEFAULT;
+    CapturePixelFormat format = CAPTURE_FORMAT_RGBA_8888;
     int width = 0;
     int height = 0;
+
+    // 回调线程只异步取图并投递，等栅栏和转换都在 worker 中完成；只保留最新一帧
+    std::thread worker;
+    std::mutex pending_mutex;
+    std::condition_variable pending_cv;
+    PendingImage pending;
+    bool stopping = false;
+
+    CaptureCounters counters;
+
+    // 看门狗状态：last_frame_ns 由 worker 更新，其余只在看门狗线程持 g_capturer_mutex 时访问
+    std::atomic<int64_t> last_frame_ns{0};
+    // 生产者送出图像、但尚未转换出对应帧的起始时间，0 表示没有积压；画面静止时生产者不送图，保持为 0
+    std::atomic<int64_t> unserved_since_ns{0};
+    std::atomic<int64_t> frames_since_rebuild{0};
+    std::atomic<bool> stalled{false};
+    int64_t last_rebuild_ns = 0;
+    int backoff_shift = 0;
+
+    // 读取器占满时 worker 空出槽位后补取一次，否则静止画面的最后一帧会一直留在队列里
+    std::atomic<bool> acquire_deferred{false};
+    int reader_depth = kAdaptiveMinDepth;
+    std::atomic<uint32_t> fixed_depth{0};
+    int64_t depth_window_start_ns = 0;
+    int64_t depth_window_full_base = 0;
 };
 
-static NativeCapturer *g_capturer = nullptr;
+// 每个显示一个采集会话，与帧池一一对应
+static NativeCapturer *g_capturers[FRAME_POOL_COUNT] = {};
+static std::mutex g_capturer_mutex;
 
-static void onImageAvailable(void *context, AImageReader *reader) {
-    (void) context;
+static bool WriteImagePlanesToFrame(FramePool *pool, AImage *image, const FrameTiming *timing) {
+    int32_t planeCount = 0;
+    if (AImage_getNumberOfPlanes(image, &planeCount) != AMEDIA_OK || planeCount != 3) {
+        return false;
+    }
 
-    AImage *image = nullptr;
-    if (AImageReader_acquireLatestImage(reader, &image) != AMEDIA_OK || !image) {
+    FrameSource src{};
+    src.format = CAPTURE_FORMAT_YUV_420_888;
+    for (int i = 0; i < 3; ++i) {
+        uint8_t *data = nullptr;
+        int length = 0;
+        int32_t rowStride = 0;
+        int32_t pixelStride = 0;
+        if (AImage_getPlaneData(image, i, &data, &length) != AMEDIA_OK ||
+            AImage_getPlaneRowStride(image, i, &rowStride) != AMEDIA_OK ||
+            AImage_getPlanePixelStride(image, i, &pixelStride) != AMEDIA_OK) {
+            return false;
+        }
+        src.planes[i] = data;
+        src.row_stride[i] = rowStride;
+        src.pixel_stride[i] = pixelStride;
+    }
+    return WriteSourceToFrame(pool, &src, timing);
+}
+
+static void UpdateMax(std::atomic<int64_t> &target, int64_t value) {
+    int64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+static void ReleasePendingImage(NativeCapturer *capturer, PendingImage *item) {
+    if (item->fence >= 0) {
+        close(item->fence);
+        item->fence = -1;
+    }
+    if (item->image) {
+        AImage_delete(item->image);
+        item->image = nullptr;
+        capturer->counters.images_held.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+static bool WaitFence(int fence, int timeout_ms) {
+    pollfd pfd{fence, POLLIN, 0};
+    int ret;
+    do {
+        ret = poll(&pfd, 1, timeout_ms);
+    } while (ret < 0 && errno == EINTR);
+    return ret > 0 && (pfd.revents & POLLIN);
+}
+
+static void ProcessPendingImage(NativeCapturer *capturer, PendingImage *item) {
+    CaptureCounters &counters = capturer->counters;
+
+    if (item->fence >= 0) {
+        const int64_t waitStart = MonotonicNowNs();
+        const bool signaled = WaitFence(item->fence, kFenceTimeoutMs);
+        const int64_t waited = MonotonicNowNs() - waitStart;
+        close(item->fence);
+        item->fence = -1;
+
+        item->timing.fence_wait_ns = waited;
+        counters.fence_wait_last_ns.store(waited, std::memory_order_relaxed);
+        counters.fence_wait_total_ns.fetch_add(waited, std::memory_order_relaxed);
+        UpdateMax(counters.fence_wait_max_ns, waited);
+        if (!signaled) {
+            LOGW("capture fence not signaled after %dms, frame dropped", kFenceTimeoutMs);
+            counters.fence_timeouts.fetch_add(1, std::memory_order_relaxed);
+            counters.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+            ReleasePendingImage(capturer, item);
+            return;
+        }
+    }
+
+    const int64_t convertStart = MonotonicNowNs();
+    bool written;
+    if (capturer->format == CAPTURE_FORMAT_YUV_420_888) {
+        written = WriteImagePlanesToFrame(capturer->pool, item->image, &item->timing);
+    } else {
+        AHardwareBuffer *hb = nullptr;
+        written = AImage_getHardwareBuffer(item->image, &hb) == AMEDIA_OK && hb &&
+                  WriteHardwareBufferToFrame(capturer->pool, hb, &item->timing);
+    }
+    if (written) {
+        const int64_t now = MonotonicNowNs();
+        const int64_t converted = now - convertStart;
+        capturer->last_frame_ns.store(now, std::memory_order_relaxed);
+        // 只清除本帧取图前开始的积压；acquireLatest 取的是最新图像，之前的通知都已覆盖
+        int64_t unserved = capturer->unserved_since_ns.load(std::memory_order_relaxed);
+        if (unserved != 0 && unserved <= item->timing.acquire_time_ns) {
+            capturer->unserved_since_ns.compare_exchange_strong(unserved, 0,
+                                                                std::memory_order_relaxed);
+        }
+        capturer->frames_since_rebuild.fetch_add(1, std::memory_order_relaxed);
+        capturer->stalled.store(false, std::memory_order_relaxed);
+        counters.convert_last_ns.store(converted, std::memory_order_relaxed);
+        counters.convert_total_ns.fetch_add(converted, std::memory_order_relaxed);
+        counters.frames_converted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 预览只跟随默认显示；栅栏已触发，渲染线程可直接采样。预览持有的是缓冲区引用，
+    // AImage 随即归还读取器，不再占住槽位；代价是生产者可能在渲染前复用该缓冲区，预览偶有撕裂
+    if (capturer->display_id == FRAME_DISPLAY_DEFAULT && IsPreviewEnabled()) {
+        AHardwareBuffer *hb = nullptr;
+        if (AImage_getHardwareBuffer(item->image, &hb) == AMEDIA_OK && hb) {
+            DispatchPreview(hb, item->timing.producer_time_ns);
+        }
+    }
+    ReleasePendingImage(capturer, item);
+}
+
+static void AcquireLatestImage(NativeCapturer *capturer, AImageReader *reader);
+
+static void CaptureWorkerLoop(NativeCapturer *capturer) {
+    while (true) {
+        PendingImage item;
+        {
+            std::unique_lock<std::mutex> lock(capturer->pending_mutex);
+            capturer->pending_cv.wait(lock, [capturer] {
+                return capturer->stopping || capturer->pending.image;
+            });
+            if (capturer->stopping) {
+                break;
+            }
+            item = capturer->pending;
+            capturer->pending = PendingImage();
+        }
+        ProcessPendingImage(capturer, &item);
+        if (capturer->acquire_deferred.exchange(false, std::memory_order_relaxed)) {
+            AcquireLatestImage(capturer, capturer->reader);
+        }
+    }
+}
+
+static void AcquireLatestImage(NativeCapturer *capturer, AImageReader *reader) {
+    PendingImage item;
+    media_status_t status = AImageReader_acquireLatestImageAsync(reader, &item.image, &item.fence);
+    if (status == AMEDIA_IMGREADER_MAX_IMAGES_ACQUIRED) {
+        capturer->counters.reader_full_events.fetch_add(1, std::memory_order_relaxed);
+        capturer->acquire_deferred.store(true, std::memory_order_relaxed);
+        return;
+    }
+    if (status != AMEDIA_OK || !item.image) {
         return;
     }
 
-    AHardwareBuffer *hb = nullptr;
-    if (AImage_getHardwareBuffer(image, &hb) == AMEDIA_OK && hb) {
-        WriteHardwareBufferToFrame(hb);
+    const int64_t held = capturer->counters.images_held.fetch_add(1, std::memory_order_relaxed) + 1;
+    UpdateMax(capturer->counters.images_held_max, held);
+    item.timing.acquire_time_ns = MonotonicNowNs();
+    AImage_getTimestamp(item.image, &item.timing.producer_time_ns);
+    capturer->counters.frames_acquired.fetch_add(1, std::memory_order_relaxed);
+
+    PendingImage replaced;
+    {
+        std::lock_guard<std::mutex> lock(capturer->pending_mutex);
+        if (capturer->stopping) {
+            replaced = item;
+        } else {
+            replaced = capturer->pending;
+            capturer->pending = item;
+        }
     }
+    capturer->pending_cv.notify_one();
 
-    bool handedOver = false;
-    if (IsPreviewEnabled()) {
-        handedOver = DispatchPreview(image);
+    // worker 还没取走上一帧，说明转换跟不上，直接丢弃旧帧而不是让读取器排队
+    if (replaced.image) {
+        capturer->counters.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+        ReleasePendingImage(capturer, &replaced);
     }
+}
+
+static void onImageAvailable(void *context, AImageReader *reader) {
+    auto *capturer = static_cast<NativeCapturer *>(context);
+    int64_t idle = 0;
+    capturer->unserved_since_ns.compare_exchange_strong(idle, MonotonicNowNs(),
+                                                        std::memory_order_relaxed);
+    AcquireLatestImage(capturer, reader);
+}
 
-    if (!handedOver) {
-        AImage_delete(image);
+static void onBufferRemoved(void *context, AImageReader *reader, AHardwareBuffer *buffer) {
+    (void) reader;
+    (void) buffer;
+    if (static_cast<NativeCapturer *>(context)->display_id == FRAME_DISPLAY_DEFAULT) {
+        InvalidatePreviewImageCache();
     }
 }
 
-jobject SetupNativeCapturer(JNIEnv *env, int width, int height) {
-    ReleaseNativeCapturer();
-    InitFrameBuffers(width, height);
+static NativeCapturer **FindCapturerSlot(int display_id) {
+    NativeCapturer **freeSlot = nullptr;
+    for (NativeCapturer *&slot : g_capturers) {
+        if (slot && slot->display_id == display_id) {
+            return &slot;
+        }
+        if (!slot && !freeSlot) {
+            freeSlot = &slot;
+        }
+    }
+    return freeSlot;
+}
+
+// 停止 worker 并删除读取器，帧池保留；预览队列中可能还有来自该读取器的图像，需先清空
+static void StopCapturerReader(NativeCapturer *capturer) {
+    if (capturer->reader) {
+        AImageReader_setImageListener(capturer->reader, nullptr);
+    }
+    {
+        std::lock_guard<std::mutex> lock(capturer->pending_mutex);
+        capturer->stopping = true;
+    }
+    capturer->pending_cv.notify_all();
+    if (capturer->worker.joinable()) {
+        capturer->worker.join();
+    }
+    ReleasePendingImage(capturer, &capturer->pending);
+    if (capturer->display_id == FRAME_DISPLAY_DEFAULT) {
+        DrainPreviewQueue();
+        InvalidatePreviewImageCache();
+    }
 
-    g_capturer = new NativeCapturer();
-    g_capturer->width = width;
-    g_capturer->height = height;
+    if (capturer->reader) {
+        AImageReader_setBufferRemovedListener(capturer->reader, nullptr);
+        AImageReader_delete(capturer->reader);
+        capturer->reader = nullptr;
+    }
+    capturer->window = nullptr;
+}
 
+static bool StartCapturerReader(NativeCapturer *capturer) {
     media_status_t status = AImageReader_newWithUsage(
-            width, height, AIMAGE_FORMAT_RGBA_8888,
-            AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE, 5,
-            &g_capturer->reader);
+            capturer->width, capturer->height, CaptureFormatToImageFormat(capturer->format),
+            AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE,
+            capturer->reader_depth, &capturer->reader);
     if (status != AMEDIA_OK) {
-        LOGE("AImageReader_newWithUsage failed: %d", status);
-        delete g_capturer;
-        g_capturer = nullptr;
-        ReleaseFrameBuffers();
-        return nullptr;
+        LOGE("AImageReader_newWithUsage failed: %d, format=%d", status, capturer->format);
+        capturer->reader = nullptr;
+        return false;
     }
 
-    g_capturer->listener.context = g_capturer;
-    g_capturer->listener.onImageAvailable = onImageAvailable;
-    status = AImageReader_setImageListener(g_capturer->reader, &g_capturer->listener);
+    capturer->stopping = false;
+    capturer->acquire_deferred.store(false, std::memory_order_relaxed);
+    capturer->worker = std::thread(CaptureWorkerLoop, capturer);
+    capturer->listener.context = capturer;
+    capturer->listener.onImageAvailable = onImageAvailable;
+    status = AImageReader_setImageListener(capturer->reader, &capturer->listener);
     if (status != AMEDIA_OK) {
         LOGE("SetupNativeCapturer: AImageReader_setImageListener failed: %d", status);
-        AImageReader_delete(g_capturer->reader);
-        delete g_capturer;
-        g_capturer = nullptr;
-        ReleaseFrameBuffers();
-        return nullptr;
+        StopCapturerReader(capturer);
+        return false;
     }
 
-    status = AImageReader_getWindow(g_capturer->reader, &g_capturer->window);
-    if (status != AMEDIA_OK || !g_capturer->window) {
+    capturer->buffer_listener.context = capturer;
+    capturer->buffer_listener.onBufferRemoved = onBufferRemoved;
+    AImageReader_setBufferRemovedListener(capturer->reader, &capturer->buffer_listener);
+
+    status = AImageReader_getWindow(capturer->reader, &capturer->window);
+    if (status != AMEDIA_OK || !capturer->window) {
         LOGE("SetupNativeCapturer: AImageReader_getWindow failed: status=%d, window=%p",
-             status, g_capturer->window);
-        AImageReader_setImageListener(g_capturer->reader, nullptr);
-        AImageReader_delete(g_capturer->reader);
-        delete g_capturer;
-        g_capturer = nullptr;
-        ReleaseFrameBuffers();
-        return nullptr;
+             status, capturer->window);
+        StopCapturerReader(capturer);
+        return false;
     }
+    return true;
+}
 
-    return ANativeWindow_toSurface(env, g_capturer->window);
+static void DestroyCapturer(NativeCapturer *capturer) {
+    StopCapturerReader(capturer);
+    if (capturer->pool) {
+        ReleaseFrameBuffers(capturer->pool);
+        UnclaimFramePool(capturer->pool);
+    }
+    delete capturer;
 }
 
-void ReleaseNativeCapturer() {
-    DrainPreviewQueue();
+static std::mutex g_watchdog_mutex;
+static std::condition_variable g_watchdog_cv;
+static std::thread g_watchdog_thread;
+static bool g_watchdog_stop = false;
+static std::atomic<uint32_t> g_stall_timeout_ms{kDefaultStallTimeoutMs};
+static std::atomic<bool> g_stall_auto_rebuild{false};
+static std::atomic<CaptureStallCallback> g_stall_callback{nullptr};
+static std::atomic<void *> g_stall_callback_user{nullptr};
+
+struct StallEvent {
+    int display_id;
+    uint32_t stalled_ms;
+    bool rebuilt;
+    bool stalled;
+    ANativeWindow *window;
+};
+
+// 重建读取器，帧池保留；不改动看门狗的退避状态
+static bool RestartCapturerReader(NativeCapturer *capturer) {
+    StopCapturerReader(capturer);
+    const bool rebuilt = StartCapturerReader(capturer);
+    // 旧读取器的积压随其一起丢弃
+    capturer->unserved_since_ns.store(0, std::memory_order_relaxed);
+    if (rebuilt) {
+        capturer->counters.reader_rebuilds.fetch_add(1, std::memory_order_relaxed);
+        LOGI("capture reader rebuilt: display=%d, depth=%d", capturer->display_id,
+             capturer->reader_depth);
+    }
+    return rebuilt;
+}
+
+// 因卡住而重建，记录时间和此后的帧数，用于判断重建是否恢复出帧
+static bool RebuildStalledReader(NativeCapturer *capturer, int64_t now) {
+    const bool rebuilt = RestartCapturerReader(capturer);
+    capturer->last_rebuild_ns = now;
+    capturer->frames_since_rebuild.store(0, std::memory_order_relaxed);
+    return rebuilt;
+}
+
+static void PushStallEvent(NativeCapturer *capturer, uint32_t stalled_ms, bool rebuilt,
+                           bool stalled, std::vector<StallEvent> *events) {
+    ANativeWindow *window = rebuilt ? capturer->window : nullptr;
+    if (window) {
+        ANativeWindow_acquire(window);
+    }
+    events->push_back({capturer->display_id, stalled_ms, rebuilt, stalled, window});
+}
+
+static int MaxAdaptiveDepth(const NativeCapturer *capturer) {
+    int64_t slotBytes = static_cast<int64_t>(capturer->width) * capturer->height;
+    switch (capturer->format) {
+        case CAPTURE_FORMAT_RGB_565:
+            slotBytes *= 2;
+            break;
+        case CAPTURE_FORMAT_YUV_420_888:
+            slotBytes = slotBytes * 3 / 2;
+            break;
+        default:
+            slotBytes *= 4;
+            break;
+    }
+    const int64_t byBudget = slotBytes > 0 ? kReaderMemoryBudget / slotBytes : kMaxReaderDepth;
+    return static_cast<int>(std::max<int64_t>(kAdaptiveMinDepth,
+                                              std::min<int64_t>(byBudget, kMaxReaderDepth)));
+}
+
+// 持 g_capturer_mutex 调用，深度变化时重建读取器；只由占满事件或显式设置触发，空闲时不会切换 Surface
+static void UpdateReaderDepth(NativeCapturer *capturer, int64_t now, std::vector<StallEvent> *events) {
+    const int64_t fullEvents = capturer->counters.reader_full_events.load(std::memory_order_relaxed);
+    if (capturer->depth_window_start_ns == 0 || now - capturer->depth_window_start_ns >= kDepthWindowNs) {
+        capturer->depth_window_start_ns = now;
+        capturer->depth_window_full_base = fullEvents;
+    }
+
+    int target = capturer->reader_depth;
+    const uint32_t fixedDepth = capturer->fixed_depth.load(std::memory_order_relaxed);
+    if (fixedDepth != 0) {
+        target = std::max(kMinReaderDepth, std::min(static_cast<int>(fixedDepth), kMaxReaderDepth));
+    } else if (fullEvents - capturer->depth_window_full_base >= kDepthGrowFullEvents) {
+        target = std::max(capturer->reader_depth,
+                          std::min(capturer->reader_depth + 1, MaxAdaptiveDepth(capturer)));
+        capturer->depth_window_full_base = fullEvents;
+    }
+    if (target == capturer->reader_depth) {
+        return;
+    }
+
+    LOGI("capture reader depth %d -> %d, display=%d", capturer->reader_depth, target,
+         capturer->display_id);
+    capturer->reader_depth = target;
+    const bool rebuilt = RestartCapturerReader(capturer);
+    PushStallEvent(capturer, 0, rebuilt, false, events);
+}
+
+// 持 g_capturer_mutex 调用；需要通知的事件收集到 events 中，在锁外派发
+static void CheckCapturerStall(NativeCapturer *capturer, int64_t now, std::vector<StallEvent> *events) {
+    const uint32_t timeoutMs = g_stall_timeout_ms.load(std::memory_order_relaxed);
+    if (timeoutMs == 0) {
+        return;
+    }
+    // 没有帧本身不算卡住：画面静止时生产者不送图。只有生产者已送图却迟迟转换不出帧，
+    // 或重建后新读取器一帧都没收到（切换 Surface 后合成器至少会送一帧）才计为卡住
+    const int64_t unserved = capturer->unserved_since_ns.load(std::memory_order_relaxed);
+    const bool rebuildFailed = capturer->last_rebuild_ns != 0 &&
+                               capturer->frames_since_rebuild.load(std::memory_order_relaxed) == 0;
+    int64_t since;
+    if (unserved != 0) {
+        since = std::max(unserved, capturer->last_rebuild_ns);
+    } else if (rebuildFailed) {
+        since = capturer->last_rebuild_ns;
+    } else {
+        return;
+    }
+    const int64_t timeoutNs = (static_cast<int64_t>(timeoutMs) * 1000000) << capturer->backoff_shift;
+    if (now - since < timeoutNs) {
+        return;
+    }
+
+    const uint32_t stalledMs = static_cast<uint32_t>((now - since) / 1000000);
+    bool report = false;
+    if (!capturer->stalled.exchange(true, std::memory_order_relaxed)) {
+        capturer->counters.stalls.fetch_add(1, std::memory_order_relaxed);
+        LOGW("capture stalled: display=%d, no frame for %ums since %s", capturer->display_id,
+             stalledMs, unserved != 0 ? "producer queued an image" : "reader rebuild");
+        report = true;
+    }
+
+    bool rebuilt = false;
+    if (g_stall_auto_rebuild.load(std::memory_order_relaxed)) {
+        // 上次重建没能恢复出帧，逐次放宽超时避免反复重建
+        if (rebuildFailed) {
+            capturer->backoff_shift = std::min(capturer->backoff_shift + 1, kMaxStallBackoffShift);
+        } else {
+            capturer->backoff_shift = 0;
+        }
+
+        rebuilt = RebuildStalledReader(capturer, now);
+        report = true;
+    }
 
-    if (g_capturer) {
-        if (g_capturer->reader) {
-            AImageReader_setImageListener(g_capturer->reader, nullptr);
+    if (report) {
+        PushStallEvent(capturer, stalledMs, rebuilt, true, events);
+    }
+}
+
+static void WatchdogLoop() {
+    std::vector<StallEvent> events;
+    std::unique_lock<std::mutex> lock(g_watchdog_mutex);
+    while (!g_watchdog_stop) {
+        g_watchdog_cv.wait_for(lock, std::chrono::milliseconds(kWatchdogTickMs));
+        if (g_watchdog_stop) {
+            continue;
         }
-        if (g_capturer->reader) {
-            AImageReader_delete(g_capturer->reader);
+
+        // 释放会话时会持 g_capturer_mutex 等待本线程退出，这里只能 try_lock
+        {
+            std::unique_lock<std::mutex> capturerLock(g_capturer_mutex, std::try_to_lock);
+            if (!capturerLock.owns_lock()) {
+                continue;
+            }
+            const int64_t now = MonotonicNowNs();
+            for (NativeCapturer *capturer : g_capturers) {
+                if (capturer) {
+                    CheckCapturerStall(capturer, now, &events);
+                    UpdateReaderDepth(capturer, now, &events);
+                }
+            }
         }
 
-        delete g_capturer;
-        g_capturer = nullptr;
-        LOGI("NativeCapturer released");
+        lock.unlock();
+        CaptureStallCallback callback = g_stall_callback.load(std::memory_order_acquire);
+        void *user = g_stall_callback_user.load(std::memory_order_acquire);
+        for (const StallEvent &event : events) {
+            if (event.window) {
+                UpcallCaptureSurfaceChanged(event.display_id, event.window);
+                ANativeWindow_release(event.window);
+            }
+            if (event.stalled && callback) {
+                callback(event.display_id, event.stalled_ms, event.rebuilt ? 1 : 0, user);
+            }
+        }
+        events.clear();
+        lock.lock();
     }
+}
 
-    ReleaseFrameBuffers();
+static void StartWatchdogLocked() {
+    if (g_watchdog_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_watchdog_mutex);
+        g_watchdog_stop = false;
+    }
+    g_watchdog_thread = std::thread(WatchdogLoop);
+}
+
+static void StopWatchdogLocked() {
+    for (NativeCapturer *capturer : g_capturers) {
+        if (capturer) {
+            return;
+        }
+    }
+    if (!g_watchdog_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_watchdog_mutex);
+        g_watchdog_stop = true;
+    }
+    g_watchdog_cv.notify_all();
+    g_watchdog_thread.join();
+}
+
+static void ReleaseCapturerLocked(int display_id) {
+    NativeCapturer **slot = FindCapturerSlot(display_id);
+    if (slot && *slot) {
+        DestroyCapturer(*slot);
+        *slot = nullptr;
+        LOGI("NativeCapturer released: display=%d", display_id);
+    } else if (display_id == FRAME_DISPLAY_DEFAULT) {
+        DrainPreviewQueue();
+        ReleaseFrameBuffers(DefaultFramePool());
+    }
+    if (display_id == FRAME_DISPLAY_DEFAULT) {
+        // 默认会话重建后由 Java 层在显示创建完成时重新登记
+        SetDefaultFrameDisplay(FRAME_DISPLAY_DEFAULT);
+    }
+    StopWatchdogLocked();
+}
+
+jobject SetupDisplayCapturer(JNIEnv *env, int display_id, int width, int height,
+                             CapturePixelFormat format) {
+    std::lock_guard<std::mutex> lock(g_capturer_mutex);
+    ReleaseCapturerLocked(display_id);
+
+    NativeCapturer **slot = FindCapturerSlot(display_id);
+    FramePool *pool = ClaimFramePool(display_id);
+    if (!slot || !pool) {
+        LOGE("SetupDisplayCapturer: too many capture sessions, display=%d", display_id);
+        UnclaimFramePool(pool);
+        return nullptr;
+    }
+    InitFrameBuffers(pool, width, height);
+
+    auto *capturer = new NativeCapturer();
+    capturer->pool = pool;
+    capturer->display_id = display_id;
+    capturer->format = format;
+    capturer->width = width;
+    capturer->height = height;
+    capturer->reader_depth = kAdaptiveMinDepth;
+    capturer->last_frame_ns.store(MonotonicNowNs(), std::memory_order_relaxed);
+    if (!StartCapturerReader(capturer)) {
+        DestroyCapturer(capturer);
+        return nullptr;
+    }
+
+    *slot = capturer;
+    StartWatchdogLocked();
+    return ANativeWindow_toSurface(env, capturer->window);
+}
+
+void ReleaseDisplayCapturer(int display_id) {
+    std::lock_guard<std::mutex> lock(g_capturer_mutex);
+    ReleaseCapturerLocked(display_id);
+}
+
+jobject SetupNativeCapturer(JNIEnv *env, int width, int height, CapturePixelFormat format) {
+    return SetupDisplayCapturer(env, FRAME_DISPLAY_DEFAULT, width, height, format);
+}
+
+void ReleaseNativeCapturer() {
+    ReleaseDisplayCapturer(FRAME_DISPLAY_DEFAULT);
+}
+
+BRIDGE_API int GetCaptureStats(int display_id, CaptureStats *stats) {
+    if (!stats || stats->struct_size < sizeof(uint32_t)) {
+        return -1;
+    }
+
+    CaptureStats snapshot{};
+    {
+        std::lock_guard<std::mutex> lock(g_capturer_mutex);
+        NativeCapturer **slot = FindCapturerSlot(display_id);
+        if (!slot || !*slot) {
+            return -1;
+        }
+        const CaptureCounters &counters = (*slot)->counters;
+        snapshot.frames_acquired = counters.frames_acquired.load(std::memory_order_relaxed);
+        snapshot.frames_converted = counters.frames_converted.load(std::memory_order_relaxed);
+        snapshot.frames_dropped = counters.frames_dropped.load(std::memory_order_relaxed);
+        snapshot.fence_timeouts = counters.fence_timeouts.load(std::memory_order_relaxed);
+        snapshot.fence_wait_last_ns = counters.fence_wait_last_ns.load(std::memory_order_relaxed);
+        snapshot.fence_wait_max_ns = counters.fence_wait_max_ns.load(std::memory_order_relaxed);
+        snapshot.fence_wait_total_ns = counters.fence_wait_total_ns.load(std::memory_order_relaxed);
+        snapshot.convert_last_ns = counters.convert_last_ns.load(std::memory_order_relaxed);
+        snapshot.convert_total_ns = counters.convert_total_ns.load(std::memory_order_relaxed);
+        snapshot.stalls = counters.stalls.load(std::memory_order_relaxed);
+        snapshot.reader_rebuilds = counters.reader_rebuilds.load(std::memory_order_relaxed);
+        snapshot.last_frame_age_ns =
+                MonotonicNowNs() - (*slot)->last_frame_ns.load(std::memory_order_relaxed);
+        snapshot.stalled = (*slot)->stalled.load(std::memory_order_relaxed) ? 1 : 0;
+        snapshot.reader_full_events = counters.reader_full_events.load(std::memory_order_relaxed);
+        snapshot.reader_depth = (*slot)->reader_depth;
+        snapshot.images_held = counters.images_held.load(std::memory_order_relaxed);
+        snapshot.images_held_max = counters.images_held_max.load(std::memory_order_relaxed);
+    }
+
+    // 按调用方声明的大小拷贝，旧版本结构体只拿到前面的字段
+    const uint32_t structSize = stats->struct_size;
+    snapshot.struct_size = static_cast<uint32_t>(std::min<size_t>(structSize, sizeof(CaptureStats)));
+    memcpy(stats, &snapshot, snapshot.struct_size);
+    return 0;
+}
+
+BRIDGE_API void SetCaptureWatchdog(uint32_t stall_timeout_ms, int auto_rebuild,
+                                   CaptureStallCallback callback, void *user) {
+    g_stall_callback.store(nullptr, std::memory_order_release);
+    g_stall_callback_user.store(user, std::memory_order_release);
+    g_stall_callback.store(callback, std::memory_order_release);
+    g_stall_auto_rebuild.store(auto_rebuild != 0, std::memory_order_relaxed);
+    g_stall_timeout_ms.store(stall_timeout_ms, std::memory_order_relaxed);
+}
+
+BRIDGE_API int SetCaptureReaderDepth(int display_id, uint32_t depth) {
+    {
+        std::lock_guard<std::mutex> lock(g_capturer_mutex);
+        NativeCapturer **slot = FindCapturerSlot(display_id);
+        if (!slot || !*slot) {
+            return -1;
+        }
+        (*slot)->fixed_depth.store(depth, std::memory_order_relaxed);
+    }
+    g_watchdog_cv.notify_all();
+    return 0;
 }
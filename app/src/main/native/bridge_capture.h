@@ -2,8 +2,15 @@
 #define BRIDGE_CAPTURE_H
 
 #include "bridge_internal.h"
+#include "bridge_pixel_convert.h"
 
-jobject SetupNativeCapturer(JNIEnv *env, int width, int height);
+// format 为 RGBA 以外时，YUV 可减半合成器写出和内存带宽，转换为 BGR 的开销留在采集线程
+jobject SetupNativeCapturer(JNIEnv *env, int width, int height, CapturePixelFormat format);
 void ReleaseNativeCapturer();
+// 按显示建立独立的采集会话和帧池，display_id 为 FRAME_DISPLAY_DEFAULT 时等同于上面两个接口；
+// 不能用于默认会话已登记的显示
+jobject SetupDisplayCapturer(JNIEnv *env, int display_id, int width, int height,
+                             CapturePixelFormat format);
+void ReleaseDisplayCapturer(int display_id);
 
 #endif // BRIDGE_CAPTURE_H
@@ -0,0 +1,368 @@
+#include "bridge_color_mask.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+struct ColorKeySlot {
+    bool active = false;
+    uint32_t generation = 0;
+    ColorKeyRange range{};
+};
+
+struct ColorMaskPlane {
+    int64_t frame_count = 0;
+    uint32_t generation = 0;
+    std::vector<uint64_t> bits;
+};
+
+static std::mutex g_keyMutex;
+static ColorKeySlot g_keys[COLOR_KEY_MAX];
+static uint32_t g_keyGeneration = 0;
+
+// 以下仅在采集线程写入；读者只访问自己持有的槽位
+static ColorKeySlot g_activeKeys[COLOR_KEY_MAX];
+static int g_activeKeyCount = 0;
+static int g_wordsPerRow = 0;
+static ColorMaskPlane g_planes[FRAME_BUFFER_COUNT][COLOR_KEY_MAX];
+
+static int WordsPerRow(int width) {
+    return (width + 63) / 64;
+}
+
+// OpenCV 约定：H 0~180，S、V 0~255
+static void BgrToHsv(const uint8_t *px, uint8_t *hsv) {
+    const int b = px[0];
+    const int g = px[1];
+    const int r = px[2];
+    const int v = std::max(b, std::max(g, r));
+    const int diff = v - std::min(b, std::min(g, r));
+    const int s = v ? (diff * 255 + v / 2) / v : 0;
+    int h = 0;
+    if (diff) {
+        if (v == r) {
+            h = (g - b) * 30 / diff;
+        } else if (v == g) {
+            h = 60 + (b - r) * 30 / diff;
+        } else {
+            h = 120 + (r - g) * 30 / diff;
+        }
+        if (h < 0) {
+            h += 180;
+        }
+    }
+    hsv[0] = static_cast<uint8_t>(h);
+    hsv[1] = static_cast<uint8_t>(s);
+    hsv[2] = static_cast<uint8_t>(v);
+}
+
+static inline bool InRange(const uint8_t *c, const ColorKeyRange &range) {
+    return c[0] >= range.lower[0] && c[0] <= range.upper[0] &&
+           c[1] >= range.lower[1] && c[1] <= range.upper[1] &&
+           c[2] >= range.lower[2] && c[2] <= range.upper[2];
+}
+
+static void MaskRowBgr(const uint8_t *bgr, int width, const ColorKeyRange &range,
+                       uint64_t *words) {
+    int x = 0;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    const uint8x16_t lo0 = vdupq_n_u8(range.lower[0]);
+    const uint8x16_t lo1 = vdupq_n_u8(range.lower[1]);
+    const uint8x16_t lo2 = vdupq_n_u8(range.lower[2]);
+    const uint8x16_t hi0 = vdupq_n_u8(range.upper[0]);
+    const uint8x16_t hi1 = vdupq_n_u8(range.upper[1]);
+    const uint8x16_t hi2 = vdupq_n_u8(range.upper[2]);
+    static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bitWeights = vld1q_u8(kBits);
+    for (; x <= width - 16; x += 16) {
+        uint8x16x3_t px = vld3q_u8(bgr + x * 3);
+        uint8x16_t in = vandq_u8(vcgeq_u8(px.val[0], lo0), vcleq_u8(px.val[0], hi0));
+        in = vandq_u8(in, vandq_u8(vcgeq_u8(px.val[1], lo1), vcleq_u8(px.val[1], hi1)));
+        in = vandq_u8(in, vandq_u8(vcgeq_u8(px.val[2], lo2), vcleq_u8(px.val[2], hi2)));
+        uint8x16_t bits = vandq_u8(in, bitWeights);
+        uint64_t mask = vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8);
+        words[x >> 6] |= mask << (x & 63);
+    }
+#elif defined(__SSSE3__)
+    // 48 字节 BGR 用 pshufb 拆成三个通道，每个通道 16 字节
+    static const struct ShuffleMasks {
+        __m128i m[3][3];
+
+        ShuffleMasks() {
+            for (int c = 0; c < 3; ++c) {
+                for (int chunk = 0; chunk < 3; ++chunk) {
+                    alignas(16) int8_t idx[16];
+                    for (int k = 0; k < 16; ++k) {
+                        const int src = c + 3 * k - chunk * 16;
+                        idx[k] = static_cast<int8_t>(src >= 0 && src < 16 ? src : -1);
+                    }
+                    m[c][chunk] = _mm_load_si128(reinterpret_cast<const __m128i *>(idx));
+                }
+            }
+        }
+    } kShuffle;
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+    __m128i lo[3];
+    __m128i hi[3];
+    for (int c = 0; c < 3; ++c) {
+        lo[c] = _mm_set1_epi8(static_cast<char>(range.lower[c] ^ 0x80));
+        hi[c] = _mm_set1_epi8(static_cast<char>(range.upper[c] ^ 0x80));
+    }
+    for (; x <= width - 16; x += 16) {
+        const __m128i *src = reinterpret_cast<const __m128i *>(bgr + x * 3);
+        const __m128i c0 = _mm_loadu_si128(src);
+        const __m128i c1 = _mm_loadu_si128(src + 1);
+        const __m128i c2 = _mm_loadu_si128(src + 2);
+        __m128i in = _mm_set1_epi8(-1);
+        for (int c = 0; c < 3; ++c) {
+            __m128i ch = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, kShuffle.m[c][0]),
+                                                   _mm_shuffle_epi8(c1, kShuffle.m[c][1])),
+                                      _mm_shuffle_epi8(c2, kShuffle.m[c][2]));
+            // 无符号比较：异或 0x80 后按有符号比较
+            ch = _mm_xor_si128(ch, bias);
+            __m128i out = _mm_or_si128(_mm_cmplt_epi8(ch, lo[c]), _mm_cmpgt_epi8(ch, hi[c]));
+            in = _mm_andnot_si128(out, in);
+        }
+        const uint64_t mask = static_cast<uint32_t>(_mm_movemask_epi8(in));
+        words[x >> 6] |= mask << (x & 63);
+    }
+#endif
+    for (; x < width; ++x) {
+        if (InRange(bgr + x * 3, range)) {
+            words[x >> 6] |= 1ull << (x & 63);
+        }
+    }
+}
+
+// 色相是环形的，lower[0] > upper[0] 时取 [lower, 180) ∪ [0, upper]，如红色 170~10
+static inline bool InHsvRange(const uint8_t *hsv, const ColorKeyRange &range) {
+    const bool hue = range.lower[0] <= range.upper[0]
+                     ? hsv[0] >= range.lower[0] && hsv[0] <= range.upper[0]
+                     : hsv[0] >= range.lower[0] || hsv[0] <= range.upper[0];
+    return hue && hsv[1] >= range.lower[1] && hsv[1] <= range.upper[1] &&
+           hsv[2] >= range.lower[2] && hsv[2] <= range.upper[2];
+}
+
+static void MaskRowHsv(const uint8_t *bgr, int width, const ColorKeyRange &range,
+                       uint64_t *words) {
+    for (int x = 0; x < width; ++x) {
+        uint8_t hsv[3];
+        BgrToHsv(bgr + x * 3, hsv);
+        if (InHsvRange(hsv, range)) {
+            words[x >> 6] |= 1ull << (x & 63);
+        }
+    }
+}
+
+static bool BeginColorMask(const FrameBuffer *frame) {
+    {
+        std::lock_guard<std::mutex> lock(g_keyMutex);
+        g_activeKeyCount = 0;
+        for (int k = 0; k < COLOR_KEY_MAX; ++k) {
+            g_activeKeys[k] = g_keys[k];
+            if (g_keys[k].active) {
+                ++g_activeKeyCount;
+            }
+        }
+    }
+
+    g_wordsPerRow = WordsPerRow(frame->width);
+    const size_t words = static_cast<size_t>(g_wordsPerRow) * frame->height;
+    for (int k = 0; k < COLOR_KEY_MAX; ++k) {
+        ColorMaskPlane &plane = g_planes[frame->index][k];
+        plane.frame_count = 0;
+        if (g_activeKeys[k].active) {
+            plane.bits.assign(words, 0);
+            plane.generation = g_activeKeys[k].generation;
+        } else {
+            std::vector<uint64_t>().swap(plane.bits);
+        }
+    }
+    return g_activeKeyCount > 0;
+}
+
+static void AccumulateColorMaskRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    for (int k = 0; k < COLOR_KEY_MAX; ++k) {
+        const ColorKeySlot &key = g_activeKeys[k];
+        if (!key.active) {
+            continue;
+        }
+        uint64_t *words = g_planes[frame->index][k].bits.data() +
+                          static_cast<size_t>(y) * g_wordsPerRow;
+        if (key.range.space == COLOR_SPACE_HSV) {
+            MaskRowHsv(bgr, frame->width, key.range, words);
+        } else {
+            MaskRowBgr(bgr, frame->width, key.range, words);
+        }
+    }
+}
+
+static void CommitColorMask(const FrameBuffer *frame) {
+    for (int k = 0; k < COLOR_KEY_MAX; ++k) {
+        if (g_activeKeys[k].active) {
+            g_planes[frame->index][k].frame_count = frame->frame_count;
+        }
+    }
+}
+
+static void ReleaseColorMask() {
+    for (auto &slot : g_planes) {
+        for (ColorMaskPlane &plane : slot) {
+            plane.frame_count = 0;
+            std::vector<uint64_t>().swap(plane.bits);
+        }
+    }
+}
+
+const FrameAnalyzer kColorMaskAnalyzer = {
+        BeginColorMask,
+        AccumulateColorMaskRow,
+        CommitColorMask,
+        ReleaseColorMask,
+};
+
+// 锁定当前帧并返回该颜色键在此帧上的掩码；失败时已解锁
+static const ColorMaskPlane *LockColorMask(int key_id, const FrameBuffer **frame_out) {
+    if (key_id < 0 || key_id >= COLOR_KEY_MAX) {
+        return nullptr;
+    }
+
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(g_keyMutex);
+        if (!g_keys[key_id].active) {
+            return nullptr;
+        }
+        generation = g_keys[key_id].generation;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return nullptr;
+    }
+
+    const ColorMaskPlane &plane = g_planes[frame->index][key_id];
+    if (plane.frame_count != frame->frame_count || plane.generation != generation ||
+        plane.bits.empty()) {
+        UnlockFrame(frame);
+        return nullptr;
+    }
+    *frame_out = frame;
+    return &plane;
+}
+
+BRIDGE_API int RegisterColorKey(const ColorKeyRange *range) {
+    if (!range || (range->space != COLOR_SPACE_BGR && range->space != COLOR_SPACE_HSV)) {
+        return -1;
+    }
+    // 只有 HSV 的色相允许首尾相接，其余通道下界不能大于上界
+    for (int c = range->space == COLOR_SPACE_HSV ? 1 : 0; c < 3; ++c) {
+        if (range->lower[c] > range->upper[c]) {
+            LOGW("RegisterColorKey: channel %d lower %d > upper %d", c, range->lower[c],
+                 range->upper[c]);
+            return -1;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(g_keyMutex);
+    for (int k = 0; k < COLOR_KEY_MAX; ++k) {
+        if (!g_keys[k].active) {
+            g_keys[k].active = true;
+            g_keys[k].generation = ++g_keyGeneration;
+            g_keys[k].range = *range;
+            return k;
+        }
+    }
+    LOGW("RegisterColorKey: all %d keys in use", COLOR_KEY_MAX);
+    return -1;
+}
+
+BRIDGE_API int UnregisterColorKey(int key_id) {
+    if (key_id < 0 || key_id >= COLOR_KEY_MAX) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(g_keyMutex);
+    g_keys[key_id].active = false;
+    return 0;
+}
+
+BRIDGE_API int CountColorKeyPixels(int key_id, const RoiRect *rects, uint32_t count,
+                                   uint32_t *out) {
+    if (!rects || !out) {
+        return -1;
+    }
+
+    const FrameBuffer *frame = nullptr;
+    const ColorMaskPlane *plane = LockColorMask(key_id, &frame);
+    if (!plane) {
+        return -1;
+    }
+
+    const int wordsPerRow = WordsPerRow(frame->width);
+    for (uint32_t i = 0; i < count; ++i) {
+        const RoiRect &rect = rects[i];
+        const int x0 = std::max(rect.x, 0);
+        const int y0 = std::max(rect.y, 0);
+        const int x1 = std::min(rect.x + rect.width, frame->width);
+        const int y1 = std::min(rect.y + rect.height, frame->height);
+        out[i] = 0;
+        if (x1 <= x0 || y1 <= y0) {
+            continue;
+        }
+
+        const int w0 = x0 >> 6;
+        const int w1 = (x1 - 1) >> 6;
+        const uint64_t headMask = ~0ull << (x0 & 63);
+        const uint64_t tailMask = ~0ull >> (63 - ((x1 - 1) & 63));
+        uint32_t total = 0;
+        for (int y = y0; y < y1; ++y) {
+            const uint64_t *row = plane->bits.data() + static_cast<size_t>(y) * wordsPerRow;
+            if (w0 == w1) {
+                total += __builtin_popcountll(row[w0] & headMask & tailMask);
+                continue;
+            }
+            total += __builtin_popcountll(row[w0] & headMask);
+            for (int w = w0 + 1; w < w1; ++w) {
+                total += __builtin_popcountll(row[w]);
+            }
+            total += __builtin_popcountll(row[w1] & tailMask);
+        }
+        out[i] = total;
+    }
+
+    UnlockFrame(frame);
+    return static_cast<int>(count);
+}
+
+BRIDGE_API int GetLockedColorKeyMask(int key_id, ColorKeyMask *mask) {
+    if (!mask) {
+        return -1;
+    }
+    *mask = ColorKeyMask{};
+
+    const FrameBuffer *frame = nullptr;
+    const ColorMaskPlane *plane = LockColorMask(key_id, &frame);
+    if (!plane) {
+        return -1;
+    }
+
+    mask->width = static_cast<uint32_t>(frame->width);
+    mask->height = static_cast<uint32_t>(frame->height);
+    mask->stride = static_cast<uint32_t>(WordsPerRow(frame->width) * sizeof(uint64_t));
+    mask->bits = plane->bits.data();
+    mask->frame_ref = const_cast<FrameBuffer *>(frame);
+    return 0;
+}
+
+BRIDGE_API int UnlockColorKeyMask(ColorKeyMask mask) {
+    if (mask.frame_ref) {
+        UnlockFrame(reinterpret_cast<const FrameBuffer *>(mask.frame_ref));
+    }
+    return 0;
+}
@@ -0,0 +1,8 @@
+#ifndef BRIDGE_COLOR_MASK_H
+#define BRIDGE_COLOR_MASK_H
+
+#include "bridge_frame_buffer.h"
+
+extern const FrameAnalyzer kColorMaskAnalyzer;
+
+#endif // BRIDGE_COLOR_MASK_H
@@ -1,66 +1,80 @@
 #include "bridge_frame_buffer.h"
 
+#include "bridge_color_mask.h"
+#include "bridge_frame_subscriber.h"
+#include "bridge_luma_grid.h"
+#include "bridge_motion.h"
+#include "bridge_pixel_convert.h"
+#include "bridge_roi_stats.h"
+#include "bridge_screen_classifier.h"
+#include "bridge_screen_state.h"
+
 #include <android/bitmap.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <thread>
 
-#if defined(__ARM_NEON)
-#include <arm_neon.h>
-#endif
+#define FRAME_POOL_UNUSED INT32_MIN
+
+struct FramePool {
+    FrameBuffer buffers[FRAME_BUFFER_COUNT] = {};
+    std::atomic<int> buffer_states[FRAME_BUFFER_COUNT] = {
+            FRAME_STATE_FREE, FRAME_STATE_FREE, FRAME_STATE_FREE
+    };
+    std::atomic<int> reader_counts[FRAME_BUFFER_COUNT] = {0, 0, 0};
+    std::atomic<FrameBuffer *> read_buffer{nullptr};
+    std::atomic<int64_t> frame_count{0};
+    std::atomic<bool> initialized{false};
+    std::atomic<int> display_id{FRAME_POOL_UNUSED};
+    // 按 display id 查到池后持有的引用数，非零时不会被重新认领
+    std::atomic<int> pins{0};
+    std::mutex wait_mutex;
+    std::condition_variable wait_cv;
+};
 
-static FrameBuffer g_buffers[FRAME_BUFFER_COUNT] = {};
-static std::atomic<int> g_buffer_states[FRAME_BUFFER_COUNT] = {
-        FRAME_STATE_FREE, FRAME_STATE_FREE, FRAME_STATE_FREE
+// 池对象常驻不释放，读者拿到的指针始终有效；g_pools[0] 固定为默认显示，分析器只作用于它
+static FramePool g_pools[FRAME_POOL_COUNT];
+static std::mutex g_pool_claim_mutex;
+static std::atomic<int> g_default_display_id{FRAME_DISPLAY_DEFAULT};
+
+static const FrameAnalyzer *const kFrameAnalyzers[] = {
+        &kScreenStateAnalyzer,
+        &kRoiStatsAnalyzer,
+        &kScreenClassifierAnalyzer,
+        &kColorMaskAnalyzer,
+        &kMotionAnalyzer,
+        &kFrameSubscriberAnalyzer,
 };
-static std::atomic<int> g_reader_counts[FRAME_BUFFER_COUNT] = {0, 0, 0};
-static std::atomic<FrameBuffer *> g_read_buffer{nullptr};
-static std::atomic<int64_t> g_frame_count{0};
-static std::atomic<bool> g_frame_buffers_initialized{false};
-
-static void ProcessFrameDataV2(
-        const uint8_t *__restrict src,
-        uint8_t *__restrict dst_bgr,
-        int width,
-        int height,
-        int src_stride) {
-    for (int y = 0; y < height; ++y) {
-        const uint8_t *s = src + static_cast<size_t>(y) * src_stride;
-        uint8_t *d3 = dst_bgr + y * width * 3;
-        int x = 0;
-
-#if defined(__ARM_NEON)
-        for (; x <= width - 16; x += 16) {
-            uint8x16x4_t rgba = vld4q_u8(s);
-            s += 64;
-            uint8x16x3_t bgr;
-            bgr.val[0] = rgba.val[2];
-            bgr.val[1] = rgba.val[1];
-            bgr.val[2] = rgba.val[0];
-            vst3q_u8(d3, bgr);
-            d3 += 48;
-        }
-        for (; x <= width - 8; x += 8) {
-            uint8x8x4_t rgba = vld4_u8(s);
-            s += 32;
-            uint8x8x3_t bgr;
-            bgr.val[0] = rgba.val[2];
-            bgr.val[1] = rgba.val[1];
-            bgr.val[2] = rgba.val[0];
-            vst3_u8(d3, bgr);
-            d3 += 24;
+static constexpr int kFrameAnalyzerCount = sizeof(kFrameAnalyzers) / sizeof(kFrameAnalyzers[0]);
+
+static void ProcessFrameDataV2(const FrameSource *src, FrameBuffer *target) {
+    const int width = target->width;
+    const int height = target->height;
+
+    const FrameAnalyzer *active[kFrameAnalyzerCount];
+    int activeCount = 0;
+    for (const FrameAnalyzer *analyzer : kFrameAnalyzers) {
+        if (target->pool == DefaultFramePool() && analyzer->begin(target)) {
+            active[activeCount++] = analyzer;
         }
-#endif
-        for (; x < width; ++x) {
-            d3[0] = s[2];
-            d3[1] = s[1];
-            d3[2] = s[0];
-            s += 4;
-            d3 += 3;
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uint8_t *row = target->bgr_data + static_cast<size_t>(y) * width * 3;
+        ConvertSourceRowToBgr(src, y, row, width);
+        for (int i = 0; i < activeCount; ++i) {
+            active[i]->row(target, y, row);
         }
     }
+
+    for (int i = 0; i < activeCount; ++i) {
+        active[i]->end(target);
+    }
 }
 
 static int GetBufferIndex(FrameBuffer *buf) {
@@ -79,13 +93,10 @@ static void ReleaseBuffer(FrameBuffer *buf) {
     buf->height = 0;
     buf->bgr_size = 0;
     buf->frame_count = 0;
-}
-
-static void MarkBufferFree(FrameBuffer *buf) {
-    int idx = GetBufferIndex(buf);
-    if (idx >= 0) {
-        g_buffer_states[idx].store(FRAME_STATE_FREE, std::memory_order_release);
-    }
+    buf->producer_time_ns = 0;
+    buf->acquire_time_ns = 0;
+    buf->commit_time_ns = 0;
+    buf->fence_wait_ns = 0;
 }
 
 static void CommitWriteBuffer(FrameBuffer *buf) {
@@ -93,35 +104,42 @@ static void CommitWriteBuffer(FrameBuffer *buf) {
     if (idx < 0) {
         return;
     }
-    g_buffer_states[idx].store(FRAME_STATE_FREE, std::memory_order_release);
-    if (g_frame_buffers_initialized.load(std::memory_order_acquire)) {
-        g_read_buffer.store(buf, std::memory_order_release);
+    FramePool *pool = buf->pool;
+    pool->buffer_states[idx].store(FRAME_STATE_FREE, std::memory_order_release);
+    if (pool->initialized.load(std::memory_order_acquire)) {
+        pool->read_buffer.store(buf, std::memory_order_release);
     }
+    // 计数在 read_buffer 发布之后递增，看到新计数的读者锁到的不会早于这一帧
+    pool->frame_count.fetch_add(1, std::memory_order_acq_rel);
+
+    // 空锁一次再通知，避免等待方检查完条件、尚未进入等待时丢失唤醒
+    { std::lock_guard<std::mutex> lock(pool->wait_mutex); }
+    pool->wait_cv.notify_all();
 }
 
-static FrameBuffer *AcquireWriteBuffer() {
-    if (!g_frame_buffers_initialized.load(std::memory_order_acquire)) {
+static FrameBuffer *AcquireWriteBuffer(FramePool *pool) {
+    if (!pool->initialized.load(std::memory_order_acquire)) {
         return nullptr;
     }
 
-    FrameBuffer *currentReadBuffer = g_read_buffer.load(std::memory_order_acquire);
+    FrameBuffer *currentReadBuffer = pool->read_buffer.load(std::memory_order_acquire);
     for (int i = 0; i < FRAME_BUFFER_COUNT; ++i) {
-        FrameBuffer *candidate = &g_buffers[i];
+        FrameBuffer *candidate = &pool->buffers[i];
         if (candidate == currentReadBuffer ||
-            g_reader_counts[i].load(std::memory_order_acquire) > 0) {
+            pool->reader_counts[i].load(std::memory_order_acquire) > 0) {
             continue;
         }
 
         int expected = FRAME_STATE_FREE;
-        if (!g_buffer_states[i].compare_exchange_strong(expected, FRAME_STATE_WRITING,
-                                                        std::memory_order_acq_rel)) {
+        if (!pool->buffer_states[i].compare_exchange_strong(expected, FRAME_STATE_WRITING,
+                                                            std::memory_order_acq_rel)) {
             continue;
         }
 
-        if (g_reader_counts[i].load(std::memory_order_acquire) > 0 ||
-            g_read_buffer.load(std::memory_order_acquire) == candidate ||
-            !g_frame_buffers_initialized.load(std::memory_order_acquire)) {
-            g_buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
+        if (pool->reader_counts[i].load(std::memory_order_acquire) > 0 ||
+            pool->read_buffer.load(std::memory_order_acquire) == candidate ||
+            !pool->initialized.load(std::memory_order_acquire)) {
+            pool->buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
             continue;
         }
         return candidate;
@@ -129,13 +147,97 @@ static FrameBuffer *AcquireWriteBuffer() {
     return nullptr;
 }
 
-static const FrameBuffer *LockCurrentFrame() {
-    if (!g_frame_buffers_initialized.load(std::memory_order_acquire)) {
+FramePool *DefaultFramePool() {
+    return &g_pools[0];
+}
+
+void SetDefaultFrameDisplay(int display_id) {
+    g_default_display_id.store(display_id, std::memory_order_release);
+    LOGI("SetDefaultFrameDisplay: display=%d", display_id);
+}
+
+bool IsDefaultDisplay(int display_id) {
+    return display_id == FRAME_DISPLAY_DEFAULT ||
+           display_id == g_default_display_id.load(std::memory_order_acquire);
+}
+
+// 调用方持有 g_pool_claim_mutex
+static FramePool *FindClaimedPoolLocked(int display_id) {
+    for (int i = 1; i < FRAME_POOL_COUNT; ++i) {
+        if (g_pools[i].display_id.load(std::memory_order_acquire) == display_id) {
+            return &g_pools[i];
+        }
+    }
+    return nullptr;
+}
+
+FramePool *PinFramePool(int display_id) {
+    if (IsDefaultDisplay(display_id)) {
+        FramePool *pool = DefaultFramePool();
+        pool->pins.fetch_add(1);
+        return pool;
+    }
+    for (int i = 1; i < FRAME_POOL_COUNT; ++i) {
+        FramePool *pool = &g_pools[i];
+        if (pool->display_id.load() != display_id) {
+            continue;
+        }
+        // 先引用再复核，与认领时先查引用数再改 display_id 配对，二者不会同时通过
+        pool->pins.fetch_add(1);
+        if (pool->display_id.load() == display_id) {
+            return pool;
+        }
+        pool->pins.fetch_sub(1, std::memory_order_release);
+    }
+    return nullptr;
+}
+
+void UnpinFramePool(FramePool *pool) {
+    if (pool) {
+        pool->pins.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+FramePool *ClaimFramePool(int display_id) {
+    if (display_id == FRAME_DISPLAY_DEFAULT) {
+        return DefaultFramePool();
+    }
+    if (IsDefaultDisplay(display_id)) {
+        LOGE("ClaimFramePool: display %d is captured by the default session", display_id);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_pool_claim_mutex);
+    FramePool *existing = FindClaimedPoolLocked(display_id);
+    if (existing) {
+        return existing;
+    }
+    // 仍被旧显示的读者引用的池暂不复用，避免读者拿到其他显示的帧
+    for (int i = 1; i < FRAME_POOL_COUNT; ++i) {
+        if (g_pools[i].display_id.load() == FRAME_POOL_UNUSED && g_pools[i].pins.load() == 0) {
+            g_pools[i].display_id.store(display_id);
+            return &g_pools[i];
+        }
+    }
+    LOGE("ClaimFramePool: no free pool for display %d", display_id);
+    return nullptr;
+}
+
+void UnclaimFramePool(FramePool *pool) {
+    if (!pool || pool == DefaultFramePool()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_pool_claim_mutex);
+    pool->display_id.store(FRAME_POOL_UNUSED, std::memory_order_release);
+}
+
+const FrameBuffer *LockPoolFrame(FramePool *pool) {
+    if (!pool || !pool->initialized.load(std::memory_order_acquire)) {
         return nullptr;
     }
 
     for (int attempt = 0; attempt < 3; ++attempt) {
-        FrameBuffer *frame = g_read_buffer.load(std::memory_order_acquire);
+        FrameBuffer *frame = pool->read_buffer.load(std::memory_order_acquire);
         if (!frame || frame->frame_count == 0) {
             return nullptr;
         }
@@ -145,23 +247,24 @@ static const FrameBuffer *LockCurrentFrame() {
             return nullptr;
         }
 
-        g_reader_counts[idx].fetch_add(1, std::memory_order_acquire);
-        if (g_read_buffer.load(std::memory_order_acquire) != frame ||
-            !g_frame_buffers_initialized.load(std::memory_order_acquire)) {
-            g_reader_counts[idx].fetch_sub(1, std::memory_order_release);
+        pool->reader_counts[idx].fetch_add(1, std::memory_order_acquire);
+        if (pool->read_buffer.load(std::memory_order_acquire) != frame ||
+            !pool->initialized.load(std::memory_order_acquire)) {
+            pool->reader_counts[idx].fetch_sub(1, std::memory_order_release);
             continue;
         }
 
-        if (g_buffer_states[idx].load(std::memory_order_acquire) == FRAME_STATE_WRITING) {
+        if (pool->buffer_states[idx].load(std::memory_order_acquire) == FRAME_STATE_WRITING) {
             bool ready = false;
             for (int spin = 0; spin < 500; ++spin) {
-                if (g_buffer_states[idx].load(std::memory_order_acquire) != FRAME_STATE_WRITING) {
+                if (pool->buffer_states[idx].load(std::memory_order_acquire) !=
+                    FRAME_STATE_WRITING) {
                     ready = true;
                     break;
                 }
             }
             if (!ready) {
-                g_reader_counts[idx].fetch_sub(1, std::memory_order_release);
+                pool->reader_counts[idx].fetch_sub(1, std::memory_order_release);
                 return nullptr;
             }
         }
@@ -171,113 +274,198 @@ static const FrameBuffer *LockCurrentFrame() {
     return nullptr;
 }
 
-static void UnlockFrame(const FrameBuffer *frame) {
+const FrameBuffer *LockCurrentFrame() {
+    return LockPoolFrame(DefaultFramePool());
+}
+
+void UnlockFrame(const FrameBuffer *frame) {
     if (!frame) {
         return;
     }
 
     int idx = GetBufferIndex(const_cast<FrameBuffer *>(frame));
     if (idx >= 0) {
-        g_reader_counts[idx].fetch_sub(1, std::memory_order_release);
+        frame->pool->reader_counts[idx].fetch_sub(1, std::memory_order_release);
     }
 }
 
-void InitFrameBuffers(int width, int height) {
-    if (g_frame_buffers_initialized.load(std::memory_order_acquire)) {
-        ReleaseFrameBuffers();
+const FrameBuffer *LockDisplayFrame(int display_id) {
+    FramePool *pool = PinFramePool(display_id);
+    const FrameBuffer *frame = LockPoolFrame(pool);
+    if (!frame) {
+        UnpinFramePool(pool);
+    }
+    return frame;
+}
+
+void UnlockPinnedFrame(const FrameBuffer *frame) {
+    if (!frame) {
+        return;
+    }
+    FramePool *pool = frame->pool;
+    UnlockFrame(frame);
+    UnpinFramePool(pool);
+}
+
+void InitFrameBuffers(FramePool *pool, int width, int height) {
+    if (pool->initialized.load(std::memory_order_acquire)) {
+        ReleaseFrameBuffers(pool);
     }
 
     const size_t bgrSize = static_cast<size_t>(width) * height * 3;
     for (int i = 0; i < FRAME_BUFFER_COUNT; ++i) {
-        FrameBuffer &buf = g_buffers[i];
+        FrameBuffer &buf = pool->buffers[i];
         ReleaseBuffer(&buf);
         if (posix_memalign(reinterpret_cast<void **>(&buf.bgr_data), 64, bgrSize) != 0) {
             LOGE("InitFrameBuffers: posix_memalign failed at index=%d", i);
             for (int j = 0; j <= i; ++j) {
-                ReleaseBuffer(&g_buffers[j]);
-                g_buffer_states[j].store(FRAME_STATE_FREE, std::memory_order_release);
-                g_reader_counts[j].store(0, std::memory_order_release);
+                ReleaseBuffer(&pool->buffers[j]);
+                pool->buffer_states[j].store(FRAME_STATE_FREE, std::memory_order_release);
+                pool->reader_counts[j].store(0, std::memory_order_release);
             }
-            g_read_buffer.store(nullptr, std::memory_order_release);
-            g_frame_count.store(0, std::memory_order_release);
+            pool->read_buffer.store(nullptr, std::memory_order_release);
+            pool->frame_count.store(0, std::memory_order_release);
             return;
         }
 
         buf.index = i;
+        buf.pool = pool;
         buf.width = width;
         buf.height = height;
         buf.bgr_size = bgrSize;
         buf.frame_count = 0;
-        g_buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
-        g_reader_counts[i].store(0, std::memory_order_release);
+        buf.producer_time_ns = 0;
+        buf.acquire_time_ns = 0;
+        buf.commit_time_ns = 0;
+        buf.fence_wait_ns = 0;
+        pool->buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
+        pool->reader_counts[i].store(0, std::memory_order_release);
     }
 
-    g_read_buffer.store(nullptr, std::memory_order_release);
-    g_frame_count.store(0, std::memory_order_release);
-    g_frame_buffers_initialized.store(true, std::memory_order_release);
+    pool->read_buffer.store(nullptr, std::memory_order_release);
+    pool->frame_count.store(0, std::memory_order_release);
+    pool->initialized.store(true, std::memory_order_release);
     LOGI("InitFrameBuffers: Success %dx%d", width, height);
 }
 
-void ReleaseFrameBuffers() {
-    g_frame_buffers_initialized.store(false, std::memory_order_release);
-    g_read_buffer.store(nullptr, std::memory_order_release);
+void ReleaseFrameBuffers(FramePool *pool) {
+    pool->initialized.store(false, std::memory_order_release);
+    pool->read_buffer.store(nullptr, std::memory_order_release);
 
     for (int i = 0; i < FRAME_BUFFER_COUNT; ++i) {
-        while (g_buffer_states[i].load(std::memory_order_acquire) == FRAME_STATE_WRITING ||
-               g_reader_counts[i].load(std::memory_order_acquire) > 0) {
+        while (pool->buffer_states[i].load(std::memory_order_acquire) == FRAME_STATE_WRITING ||
+               pool->reader_counts[i].load(std::memory_order_acquire) > 0) {
             std::this_thread::yield();
         }
 
-        ReleaseBuffer(&g_buffers[i]);
-        g_buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
-        g_reader_counts[i].store(0, std::memory_order_release);
+        ReleaseBuffer(&pool->buffers[i]);
+        pool->buffer_states[i].store(FRAME_STATE_FREE, std::memory_order_release);
+        pool->reader_counts[i].store(0, std::memory_order_release);
     }
 
-    g_read_buffer.store(nullptr, std::memory_order_release);
-    g_frame_count.store(0, std::memory_order_release);
+    pool->read_buffer.store(nullptr, std::memory_order_release);
+    pool->frame_count.store(0, std::memory_order_release);
+
+    if (pool == DefaultFramePool()) {
+        for (const FrameAnalyzer *analyzer : kFrameAnalyzers) {
+            analyzer->release();
+        }
+    }
 }
 
-bool WriteHardwareBufferToFrame(AHardwareBuffer *buffer) {
-    if (!buffer || !g_frame_buffers_initialized.load(std::memory_order_acquire)) {
+bool WriteSourceToFrame(FramePool *pool, const FrameSource *src, const FrameTiming *timing) {
+    if (!src || !pool || !pool->initialized.load(std::memory_order_acquire)) {
         return false;
     }
 
-    FrameBuffer *target = AcquireWriteBuffer();
+    FrameBuffer *target = AcquireWriteBuffer(pool);
     if (!target) {
         return false;
     }
 
-    void *srcAddr = nullptr;
-    if (AHardwareBuffer_lock(buffer, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1, nullptr,
-                             &srcAddr) != 0) {
-        MarkBufferFree(target);
+    // 分析器在 end 中按 frame_count 标记结果，需在转换前确定序号；单写者，load + 1 即为本帧序号
+    target->frame_count = pool->frame_count.load(std::memory_order_acquire) + 1;
+    ProcessFrameDataV2(src, target);
+
+    target->acquire_time_ns = timing ? timing->acquire_time_ns : 0;
+    target->producer_time_ns = timing && timing->producer_time_ns > 0
+                               ? timing->producer_time_ns : target->acquire_time_ns;
+    target->fence_wait_ns = timing ? timing->fence_wait_ns : 0;
+    target->commit_time_ns = MonotonicNowNs();
+#ifdef ENABLE_FRAME_TIMING
+    LOGI("frame #%lld: producer->acquire %.2fms, fence wait %.2fms, acquire->commit %.2fms",
+         static_cast<long long>(target->frame_count),
+         (target->acquire_time_ns - target->producer_time_ns) / 1e6,
+         target->fence_wait_ns / 1e6,
+         (target->commit_time_ns - target->acquire_time_ns) / 1e6);
+#endif
+    CommitWriteBuffer(target);
+    return true;
+}
+
+bool WriteHardwareBufferToFrame(FramePool *pool, AHardwareBuffer *buffer,
+                                const FrameTiming *timing) {
+    if (!buffer) {
         return false;
     }
 
     AHardwareBuffer_Desc desc;
     AHardwareBuffer_describe(buffer, &desc);
-    ProcessFrameDataV2(static_cast<uint8_t *>(srcAddr), target->bgr_data, target->width,
-                       target->height, static_cast<int>(desc.stride) * 4);
+    FrameSource src{};
+    switch (desc.format) {
+        case AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:
+            src.format = CAPTURE_FORMAT_RGBA_8888;
+            src.pixel_stride[0] = 4;
+            break;
+        case AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM:
+            src.format = CAPTURE_FORMAT_RGBX_8888;
+            src.pixel_stride[0] = 4;
+            break;
+        case AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM:
+            src.format = CAPTURE_FORMAT_RGB_565;
+            src.pixel_stride[0] = 2;
+            break;
+        default:
+            // YUV 需要按平面读取，由调用方通过 AImage 平面接口走 WriteSourceToFrame
+            return false;
+    }
+
+    void *srcAddr = nullptr;
+    if (AHardwareBuffer_lock(buffer, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1, nullptr,
+                             &srcAddr) != 0) {
+        return false;
+    }
+    src.planes[0] = static_cast<const uint8_t *>(srcAddr);
+    src.row_stride[0] = static_cast<int>(desc.stride) * src.pixel_stride[0];
+    bool written = WriteSourceToFrame(pool, &src, timing);
     AHardwareBuffer_unlock(buffer, nullptr);
+    return written;
+}
 
-    target->frame_count = g_frame_count.fetch_add(1, std::memory_order_acq_rel) + 1;
-    CommitWriteBuffer(target);
-    return true;
+int64_t GetPoolFrameCount(FramePool *pool) {
+    return pool ? pool->frame_count.load(std::memory_order_acquire) : 0;
 }
 
 int64_t GetFrameCount() {
-    return g_frame_count.load(std::memory_order_acquire);
+    return GetPoolFrameCount(DefaultFramePool());
 }
 
-BRIDGE_API FrameInfo GetLockedPixels() {
+bool WaitForFrameAfter(FramePool *pool, int64_t frame_count, uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(pool->wait_mutex);
+    return pool->wait_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [pool, frame_count] {
+        return pool->frame_count.load(std::memory_order_acquire) > frame_count;
+    });
+}
+
+BRIDGE_API FrameInfo GetLockedPixelsForDisplay(int display_id) {
     FrameInfo result = {0};
-    const FrameBuffer *frame = LockCurrentFrame();
+    const FrameBuffer *frame = LockDisplayFrame(display_id);
     if (!frame) {
         return result;
     }
 
     if (!frame->bgr_data) {
-        UnlockFrame(frame);
+        UnlockPinnedFrame(frame);
         return result;
     }
 
@@ -290,9 +478,159 @@ BRIDGE_API FrameInfo GetLockedPixels() {
     return result;
 }
 
+BRIDGE_API FrameInfo GetLockedPixels() {
+    return GetLockedPixelsForDisplay(FRAME_DISPLAY_DEFAULT);
+}
+
 BRIDGE_API int UnlockPixels(FrameInfo info) {
     if (info.frame_ref) {
-        UnlockFrame(reinterpret_cast<const FrameBuffer *>(info.frame_ref));
+        UnlockPinnedFrame(reinterpret_cast<const FrameBuffer *>(info.frame_ref));
+    }
+    return 0;
+}
+
+// 按 struct_size 判断调用方结构体是否包含某字段，兼容旧版本调用方
+#define HAS_FIELD(ptr, type, field) \
+    ((ptr)->struct_size >= offsetof(type, field) + sizeof(((type *) nullptr)->field))
+
+static void ConvertBgrToRgba(const uint8_t *bgr, uint8_t *dst, size_t pixels) {
+    for (size_t i = 0; i < pixels; ++i) {
+        dst[i * 4 + 0] = bgr[i * 3 + 2];
+        dst[i * 4 + 1] = bgr[i * 3 + 1];
+        dst[i * 4 + 2] = bgr[i * 3 + 0];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+static void ConvertBgrToGray(const uint8_t *bgr, uint8_t *dst, size_t pixels) {
+    for (size_t i = 0; i < pixels; ++i) {
+        dst[i] = static_cast<uint8_t>(BgrToLuma(bgr + i * 3));
+    }
+}
+
+BRIDGE_API int64_t WaitForDisplayFrame(int display_id, int64_t min_sequence,
+                                       uint32_t timeout_ms) {
+    FramePool *pool = PinFramePool(display_id);
+    if (!pool) {
+        return 0;
+    }
+    if (GetPoolFrameCount(pool) < min_sequence) {
+        WaitForFrameAfter(pool, min_sequence - 1, timeout_ms);
+    }
+    const int64_t current = GetPoolFrameCount(pool);
+    UnpinFramePool(pool);
+    return current >= min_sequence ? current : 0;
+}
+
+BRIDGE_API int64_t WaitForFrame(int64_t min_sequence, uint32_t timeout_ms) {
+    return WaitForDisplayFrame(FRAME_DISPLAY_DEFAULT, min_sequence, timeout_ms);
+}
+
+BRIDGE_API int GetLockedPixelsEx(const LockOptions *options, FrameInfoEx *info) {
+    if (!info || info->struct_size < offsetof(FrameInfoEx, frame_ref) + sizeof(void *)) {
+        return LOCK_RESULT_INVALID;
+    }
+
+    int64_t minSequence = 0;
+    uint32_t timeoutMs = 0;
+    FramePixelFormat format = FRAME_FORMAT_BGR888;
+    void *dst = nullptr;
+    size_t dstCapacity = 0;
+    int displayId = FRAME_DISPLAY_DEFAULT;
+    if (options) {
+        if (HAS_FIELD(options, LockOptions, min_sequence)) minSequence = options->min_sequence;
+        if (HAS_FIELD(options, LockOptions, timeout_ms)) timeoutMs = options->timeout_ms;
+        if (HAS_FIELD(options, LockOptions, format)) format = options->format;
+        if (HAS_FIELD(options, LockOptions, dst_capacity)) {
+            dst = options->dst;
+            dstCapacity = options->dst_capacity;
+        }
+        if (HAS_FIELD(options, LockOptions, display_id)) displayId = options->display_id;
+    }
+
+    const uint32_t structSize = info->struct_size;
+    memset(info, 0, structSize < sizeof(FrameInfoEx) ? structSize : sizeof(FrameInfoEx));
+    info->struct_size = structSize;
+
+    if (format != FRAME_FORMAT_BGR888 && format != FRAME_FORMAT_RGBA8888 &&
+        format != FRAME_FORMAT_GRAY8) {
+        return LOCK_RESULT_INVALID;
+    }
+
+    FramePool *pool = PinFramePool(displayId);
+    if (!pool) {
+        return LOCK_RESULT_INVALID;
+    }
+    if (minSequence > 0 && GetPoolFrameCount(pool) < minSequence && timeoutMs > 0) {
+        WaitForFrameAfter(pool, minSequence - 1, timeoutMs);
+    }
+
+    // 池引用随帧锁一起交给调用方，UnlockPixelsEx 时释放
+    const FrameBuffer *frame = LockPoolFrame(pool);
+    if (!frame) {
+        UnpinFramePool(pool);
+        return LOCK_RESULT_NO_FRAME;
+    }
+    if (!frame->bgr_data || frame->frame_count < minSequence) {
+        UnlockPinnedFrame(frame);
+        return LOCK_RESULT_NO_FRAME;
+    }
+
+    const size_t pixels = static_cast<size_t>(frame->width) * frame->height;
+    info->width = frame->width;
+    info->height = frame->height;
+    info->format = format;
+    info->sequence = frame->frame_count;
+    info->timestamp_ns = frame->producer_time_ns;
+    if (HAS_FIELD(info, FrameInfoEx, commit_time_ns)) {
+        info->acquire_time_ns = frame->acquire_time_ns;
+        info->commit_time_ns = frame->commit_time_ns;
+        info->lock_time_ns = MonotonicNowNs();
+    }
+    if (HAS_FIELD(info, FrameInfoEx, fence_wait_ns)) {
+        info->fence_wait_ns = frame->fence_wait_ns;
+    }
+    if (HAS_FIELD(info, FrameInfoEx, distance)) {
+        ScreenClassification screen{-1, -1, 0};
+        if (pool == DefaultFramePool()) {
+            ClassifyLockedFrame(frame, &screen);
+        }
+        info->screen_id = screen.screen_id;
+        info->distance = screen.distance;
+    }
+
+    if (format == FRAME_FORMAT_BGR888) {
+        info->stride = frame->width * 3;
+        info->length = static_cast<uint32_t>(frame->bgr_size);
+        info->data = frame->bgr_data;
+        info->frame_ref = const_cast<FrameBuffer *>(frame);
+        return LOCK_RESULT_OK;
+    }
+
+    // 其他格式转换到调用方缓冲区后立即解锁，frame_ref 为空
+    const int bpp = format == FRAME_FORMAT_RGBA8888 ? 4 : 1;
+    const size_t length = pixels * bpp;
+    if (!dst || dstCapacity < length) {
+        UnlockPinnedFrame(frame);
+        return LOCK_RESULT_INVALID;
+    }
+    if (format == FRAME_FORMAT_RGBA8888) {
+        ConvertBgrToRgba(frame->bgr_data, static_cast<uint8_t *>(dst), pixels);
+    } else {
+        ConvertBgrToGray(frame->bgr_data, static_cast<uint8_t *>(dst), pixels);
+    }
+    const int width = frame->width;
+    UnlockPinnedFrame(frame);
+
+    info->stride = width * bpp;
+    info->length = static_cast<uint32_t>(length);
+    info->data = dst;
+    return LOCK_RESULT_OK;
+}
+
+BRIDGE_API int UnlockPixelsEx(const FrameInfoEx *info) {
+    if (info && info->frame_ref) {
+        UnlockPinnedFrame(reinterpret_cast<const FrameBuffer *>(info->frame_ref));
     }
     return 0;
 }
@@ -360,6 +698,27 @@ static jobject BuildArgb8888BitmapFromBgr(JNIEnv *env, const uint8_t *bgr, int w
     return bitmap;
 }
 
+jlongArray CreateFrameTimestampArray(JNIEnv *env) {
+    jlong values[5] = {0};
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (frame) {
+        values[0] = frame->frame_count;
+        values[1] = frame->producer_time_ns;
+        values[2] = frame->acquire_time_ns;
+        values[3] = frame->commit_time_ns;
+        UnlockFrame(frame);
+    }
+    values[4] = MonotonicNowNs();
+
+    jlongArray result = env->NewLongArray(5);
+    if (!result) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    env->SetLongArrayRegion(result, 0, 5, values);
+    return result;
+}
+
 jobject CreateFrameBufferBitmap(JNIEnv *env) {
     FrameInfo frame = GetLockedPixels();
     if (!frame.data || frame.width == 0 || frame.height == 0 || frame.length == 0) {
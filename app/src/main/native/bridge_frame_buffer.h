@@ -2,6 +2,7 @@
 #define BRIDGE_FRAME_BUFFER_H
 
 #include "bridge_internal.h"
+#include "bridge_pixel_convert.h"
 
 #include <android/hardware_buffer.h>
 
@@ -12,19 +13,68 @@ typedef enum {
 
 #define FRAME_BUFFER_COUNT 3
 
+// producer_time_ns 来自 AImage_getTimestamp，acquire_time_ns 为回调中取到图像的时刻，均为 CLOCK_MONOTONIC；
+// fence_wait_ns 为等待合成器栅栏的耗时
+typedef struct {
+    int64_t producer_time_ns;
+    int64_t acquire_time_ns;
+    int64_t fence_wait_ns;
+} FrameTiming;
+
+#define FRAME_POOL_COUNT 4
+
+struct FramePool;
+
 typedef struct {
     uint8_t *bgr_data;
     size_t bgr_size;
     int64_t frame_count;
+    int64_t producer_time_ns;
+    int64_t acquire_time_ns;
+    int64_t commit_time_ns;
+    int64_t fence_wait_ns;
     int width;
     int height;
     int index;
+    FramePool *pool;
 } FrameBuffer;
 
-void InitFrameBuffers(int width, int height);
-void ReleaseFrameBuffers();
-bool WriteHardwareBufferToFrame(AHardwareBuffer *buffer);
+// 转换过程中逐行回调，row 为刚写入的 BGR 行，此时仍在缓存中
+struct FrameAnalyzer {
+    bool (*begin)(const FrameBuffer *frame);
+    void (*row)(const FrameBuffer *frame, int y, const uint8_t *bgr);
+    void (*end)(const FrameBuffer *frame);
+    void (*release)();
+};
+
+// 每个显示一个帧池；默认池对应 FRAME_DISPLAY_DEFAULT，其余按 display id 认领
+FramePool *DefaultFramePool();
+// 默认会话实际采集的显示 id，按该 id 查询时也返回默认池；FRAME_DISPLAY_DEFAULT 表示未知
+void SetDefaultFrameDisplay(int display_id);
+// FRAME_DISPLAY_DEFAULT 或默认会话实际采集的显示 id
+bool IsDefaultDisplay(int display_id);
+// 按 display id 查找并引用帧池，引用期间池不会被其他显示重新认领；必须 UnpinFramePool
+FramePool *PinFramePool(int display_id);
+void UnpinFramePool(FramePool *pool);
+FramePool *ClaimFramePool(int display_id);
+void UnclaimFramePool(FramePool *pool);
+
+void InitFrameBuffers(FramePool *pool, int width, int height);
+void ReleaseFrameBuffers(FramePool *pool);
+bool WriteSourceToFrame(FramePool *pool, const FrameSource *src, const FrameTiming *timing);
+bool WriteHardwareBufferToFrame(FramePool *pool, AHardwareBuffer *buffer,
+                                const FrameTiming *timing);
 jobject CreateFrameBufferBitmap(JNIEnv *env);
+jlongArray CreateFrameTimestampArray(JNIEnv *env);
 int64_t GetFrameCount();
+int64_t GetPoolFrameCount(FramePool *pool);
+bool WaitForFrameAfter(FramePool *pool, int64_t frame_count, uint32_t timeout_ms);
+const FrameBuffer *LockPoolFrame(FramePool *pool);
+// 锁定默认显示的当前帧，供分析查询使用
+const FrameBuffer *LockCurrentFrame();
+void UnlockFrame(const FrameBuffer *frame);
+// 按 display id 锁定当前帧，锁期间持有帧池引用，用 UnlockPinnedFrame 一并释放
+const FrameBuffer *LockDisplayFrame(int display_id);
+void UnlockPinnedFrame(const FrameBuffer *frame);
 
 #endif // BRIDGE_FRAME_BUFFER_H
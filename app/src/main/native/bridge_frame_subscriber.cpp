@@ -0,0 +1,401 @@
+#include "bridge_frame_subscriber.h"
+
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define SUBSCRIBER_RING_SIZE 3
+#define SUBSCRIBER_MAX_COUNT 8
+// 取消订阅时等待读者归还槽位的上限
+#define SUBSCRIBER_UNSUBSCRIBE_WAIT_MS 500
+
+// readers 为 -1 表示采集线程正在写入该槽位
+struct SubscriberSlot {
+    std::vector<uint8_t> data;
+    std::atomic<int> readers{0};
+    int64_t sequence = 0;
+    int64_t producer_time_ns = 0;
+    int64_t acquire_time_ns = 0;
+    int64_t commit_time_ns = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+struct FrameSubscriber {
+    int id = 0;
+    FrameSubscription config{};
+    int64_t min_interval_ns = 0;
+    int64_t last_publish_ns = 0;
+    std::atomic<bool> removed{false};
+    std::atomic<int> latest{-1};
+    SubscriberSlot slots[SUBSCRIBER_RING_SIZE];
+
+    // 以下仅在采集线程访问
+    int writing = -1;
+    int out_w = 0;
+    int out_h = 0;
+    int bpp = 3;
+    int src_w = 0;
+    int src_h = 0;
+    std::vector<uint16_t> col_map;
+    std::vector<uint16_t> col_count;
+    std::vector<uint16_t> row_map;
+    std::vector<uint32_t> acc;
+    int acc_rows = 0;
+};
+
+// 每次成功加锁分配一个，作为 frame_ref 交给调用方；持有订阅者引用，
+// 取消订阅后订阅者及其槽位内存要到最后一个读者解锁才释放
+struct SubscriberLock {
+    std::shared_ptr<FrameSubscriber> subscriber;
+    SubscriberSlot *slot;
+};
+
+static std::mutex g_subscriberMutex;
+static std::unordered_map<int, std::shared_ptr<FrameSubscriber>> g_subscribers;
+static uint64_t g_subscriberVersion = 0;
+static int g_nextSubscriberId = 1;
+
+// 以下仅在采集线程访问
+static std::vector<std::shared_ptr<FrameSubscriber>> g_activeSubscribers;
+static std::vector<FrameSubscriber *> g_dueSubscribers;
+static uint64_t g_activeVersion = UINT64_MAX;
+
+static int BytesPerPixel(FramePixelFormat format) {
+    return format == FRAME_FORMAT_RGBA8888 ? 4 : format == FRAME_FORMAT_GRAY8 ? 1 : 3;
+}
+
+static inline void StorePixel(FramePixelFormat format, uint32_t b, uint32_t g, uint32_t r,
+                              uint8_t *dst) {
+    switch (format) {
+        case FRAME_FORMAT_RGBA8888:
+            dst[0] = static_cast<uint8_t>(r);
+            dst[1] = static_cast<uint8_t>(g);
+            dst[2] = static_cast<uint8_t>(b);
+            dst[3] = 255;
+            break;
+        case FRAME_FORMAT_GRAY8: {
+            const uint8_t px[3] = {static_cast<uint8_t>(b), static_cast<uint8_t>(g),
+                                   static_cast<uint8_t>(r)};
+            dst[0] = static_cast<uint8_t>(BgrToLuma(px));
+            break;
+        }
+        default:
+            dst[0] = static_cast<uint8_t>(b);
+            dst[1] = static_cast<uint8_t>(g);
+            dst[2] = static_cast<uint8_t>(r);
+            break;
+    }
+}
+
+static void ResolveOutputSize(const FrameSubscriber *sub, int src_w, int src_h, int *out_w,
+                              int *out_h) {
+    int w = static_cast<int>(sub->config.width);
+    int h = static_cast<int>(sub->config.height);
+    if (w <= 0 && h <= 0) {
+        w = src_w;
+        h = src_h;
+    } else if (h <= 0) {
+        h = static_cast<int>(static_cast<int64_t>(src_h) * w / src_w);
+    } else if (w <= 0) {
+        w = static_cast<int>(static_cast<int64_t>(src_w) * h / src_h);
+    }
+    // 只做缩小，放大交给消费方
+    *out_w = std::max(1, std::min(w, src_w));
+    *out_h = std::max(1, std::min(h, src_h));
+}
+
+static void PrepareScaler(FrameSubscriber *sub, int src_w, int src_h) {
+    int outW = 0;
+    int outH = 0;
+    ResolveOutputSize(sub, src_w, src_h, &outW, &outH);
+    if (sub->src_w == src_w && sub->src_h == src_h && sub->out_w == outW && sub->out_h == outH) {
+        return;
+    }
+
+    sub->src_w = src_w;
+    sub->src_h = src_h;
+    sub->out_w = outW;
+    sub->out_h = outH;
+    sub->col_map.resize(static_cast<size_t>(src_w));
+    sub->col_count.assign(static_cast<size_t>(outW), 0);
+    for (int x = 0; x < src_w; ++x) {
+        sub->col_map[x] = static_cast<uint16_t>(static_cast<int64_t>(x) * outW / src_w);
+        sub->col_count[sub->col_map[x]] += 1;
+    }
+    sub->row_map.resize(static_cast<size_t>(src_h));
+    for (int y = 0; y < src_h; ++y) {
+        sub->row_map[y] = static_cast<uint16_t>(static_cast<int64_t>(y) * outH / src_h);
+    }
+    sub->acc.assign(static_cast<size_t>(outW) * 3, 0);
+}
+
+static int AcquireSubscriberSlot(FrameSubscriber *sub) {
+    const int latest = sub->latest.load(std::memory_order_acquire);
+    for (int i = 0; i < SUBSCRIBER_RING_SIZE; ++i) {
+        if (i == latest) {
+            continue;
+        }
+        int expected = 0;
+        if (sub->slots[i].readers.compare_exchange_strong(expected, -1,
+                                                          std::memory_order_acq_rel)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool BeginSubscribers(const FrameBuffer *frame) {
+    {
+        std::lock_guard<std::mutex> lock(g_subscriberMutex);
+        if (g_activeVersion != g_subscriberVersion) {
+            g_activeSubscribers.clear();
+            for (auto &entry : g_subscribers) {
+                g_activeSubscribers.push_back(entry.second);
+            }
+            g_activeVersion = g_subscriberVersion;
+        }
+    }
+
+    g_dueSubscribers.clear();
+    const int64_t now = MonotonicNowNs();
+    for (auto &holder : g_activeSubscribers) {
+        FrameSubscriber *sub = holder.get();
+        if (sub->removed.load(std::memory_order_acquire) ||
+            now - sub->last_publish_ns < sub->min_interval_ns) {
+            continue;
+        }
+        sub->writing = AcquireSubscriberSlot(sub);
+        if (sub->writing < 0) {
+            // 所有非最新槽位都被读者占用，本帧跳过该订阅者
+            continue;
+        }
+
+        PrepareScaler(sub, frame->width, frame->height);
+        SubscriberSlot &slot = sub->slots[sub->writing];
+        slot.data.resize(static_cast<size_t>(sub->out_w) * sub->out_h * sub->bpp);
+        slot.width = static_cast<uint32_t>(sub->out_w);
+        slot.height = static_cast<uint32_t>(sub->out_h);
+        sub->acc_rows = 0;
+        g_dueSubscribers.push_back(sub);
+    }
+    return !g_dueSubscribers.empty();
+}
+
+static void SubscriberRow(FrameSubscriber *sub, int y, const uint8_t *bgr) {
+    const FramePixelFormat format = sub->config.format;
+    uint8_t *out = sub->slots[sub->writing].data.data();
+    const size_t outStride = static_cast<size_t>(sub->out_w) * sub->bpp;
+
+    if (sub->out_w == sub->src_w && sub->out_h == sub->src_h) {
+        uint8_t *dst = out + y * outStride;
+        if (format == FRAME_FORMAT_BGR888) {
+            memcpy(dst, bgr, outStride);
+            return;
+        }
+        for (int x = 0; x < sub->src_w; ++x) {
+            StorePixel(format, bgr[x * 3], bgr[x * 3 + 1], bgr[x * 3 + 2], dst + x * sub->bpp);
+        }
+        return;
+    }
+
+    // 面积平均缩小：累加属于同一输出行的源行，整组结束时写出
+    uint32_t *acc = sub->acc.data();
+    for (int x = 0; x < sub->src_w; ++x) {
+        uint32_t *a = acc + sub->col_map[x] * 3;
+        a[0] += bgr[x * 3];
+        a[1] += bgr[x * 3 + 1];
+        a[2] += bgr[x * 3 + 2];
+    }
+    ++sub->acc_rows;
+
+    const int oy = sub->row_map[y];
+    if (y + 1 < sub->src_h && sub->row_map[y + 1] == oy) {
+        return;
+    }
+
+    uint8_t *dst = out + oy * outStride;
+    for (int ox = 0; ox < sub->out_w; ++ox) {
+        uint32_t *a = acc + ox * 3;
+        const uint32_t n = static_cast<uint32_t>(sub->col_count[ox]) * sub->acc_rows;
+        const uint32_t half = n / 2;
+        StorePixel(format, (a[0] + half) / n, (a[1] + half) / n, (a[2] + half) / n,
+                   dst + ox * sub->bpp);
+        a[0] = a[1] = a[2] = 0;
+    }
+    sub->acc_rows = 0;
+}
+
+static void AccumulateSubscribersRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    (void) frame;
+    for (FrameSubscriber *sub : g_dueSubscribers) {
+        SubscriberRow(sub, y, bgr);
+    }
+}
+
+static void PublishSubscribers(const FrameBuffer *frame) {
+    const int64_t now = MonotonicNowNs();
+    for (FrameSubscriber *sub : g_dueSubscribers) {
+        SubscriberSlot &slot = sub->slots[sub->writing];
+        slot.sequence = frame->frame_count;
+        slot.producer_time_ns = frame->producer_time_ns;
+        slot.acquire_time_ns = frame->acquire_time_ns;
+        slot.commit_time_ns = now;
+        slot.readers.store(0, std::memory_order_release);
+        sub->latest.store(sub->writing, std::memory_order_release);
+        sub->last_publish_ns = now;
+        sub->writing = -1;
+    }
+    g_dueSubscribers.clear();
+}
+
+static void ReleaseSubscribers() {
+    // 采集重建时保留订阅关系，仅作废已发布的帧
+    std::lock_guard<std::mutex> lock(g_subscriberMutex);
+    for (auto &entry : g_subscribers) {
+        entry.second->latest.store(-1, std::memory_order_release);
+    }
+}
+
+const FrameAnalyzer kFrameSubscriberAnalyzer = {
+        BeginSubscribers,
+        AccumulateSubscribersRow,
+        PublishSubscribers,
+        ReleaseSubscribers,
+};
+
+static std::shared_ptr<FrameSubscriber> FindSubscriber(int subscriber_id) {
+    std::lock_guard<std::mutex> lock(g_subscriberMutex);
+    auto it = g_subscribers.find(subscriber_id);
+    return it == g_subscribers.end() ? nullptr : it->second;
+}
+
+BRIDGE_API int SubscribeFrames(const FrameSubscription *config) {
+    if (!config || config->struct_size < sizeof(FrameSubscription)) {
+        return -1;
+    }
+    if (config->format != FRAME_FORMAT_BGR888 && config->format != FRAME_FORMAT_RGBA8888 &&
+        config->format != FRAME_FORMAT_GRAY8) {
+        return -1;
+    }
+
+    auto sub = std::make_shared<FrameSubscriber>();
+    sub->config = *config;
+    sub->bpp = BytesPerPixel(config->format);
+    sub->min_interval_ns = config->max_fps > 0 ? 1000000000LL / config->max_fps : 0;
+
+    std::lock_guard<std::mutex> lock(g_subscriberMutex);
+    if (g_subscribers.size() >= SUBSCRIBER_MAX_COUNT) {
+        LOGW("SubscribeFrames: subscriber limit %d reached", SUBSCRIBER_MAX_COUNT);
+        return -1;
+    }
+    sub->id = g_nextSubscriberId++;
+    g_subscribers[sub->id] = sub;
+    ++g_subscriberVersion;
+    return sub->id;
+}
+
+BRIDGE_API int UnsubscribeFrames(int subscriber_id) {
+    std::shared_ptr<FrameSubscriber> sub;
+    {
+        std::lock_guard<std::mutex> lock(g_subscriberMutex);
+        auto it = g_subscribers.find(subscriber_id);
+        if (it == g_subscribers.end()) {
+            return -1;
+        }
+        sub = it->second;
+        // 与读者加锁后的检查配对，二者都用顺序一致的原子操作，至少一方能看到另一方
+        sub->removed.store(true);
+        g_subscribers.erase(it);
+        ++g_subscriberVersion;
+    }
+
+    // 读者各自持有引用，这里的等待只为让调用方知道帧是否仍在使用；超时不影响内存安全
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(SUBSCRIBER_UNSUBSCRIBE_WAIT_MS);
+    for (SubscriberSlot &slot : sub->slots) {
+        while (slot.readers.load() > 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                LOGW("UnsubscribeFrames: subscriber %d still has readers", subscriber_id);
+                return -2;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return 0;
+}
+
+BRIDGE_API int GetLockedSubscriberFrame(int subscriber_id, int64_t min_sequence,
+                                        FrameInfoEx *info) {
+    if (!info || info->struct_size < offsetof(FrameInfoEx, frame_ref) + sizeof(void *)) {
+        return LOCK_RESULT_INVALID;
+    }
+    const uint32_t structSize = info->struct_size;
+    memset(info, 0, std::min<size_t>(structSize, sizeof(FrameInfoEx)));
+    info->struct_size = structSize;
+
+    std::shared_ptr<FrameSubscriber> sub = FindSubscriber(subscriber_id);
+    if (!sub) {
+        return LOCK_RESULT_INVALID;
+    }
+
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        const int idx = sub->latest.load(std::memory_order_acquire);
+        if (idx < 0) {
+            return LOCK_RESULT_NO_FRAME;
+        }
+        SubscriberSlot &slot = sub->slots[idx];
+        int readers = slot.readers.load(std::memory_order_acquire);
+        if (readers < 0 || !slot.readers.compare_exchange_strong(readers, readers + 1)) {
+            continue;
+        }
+        // 查找之后可能已被取消订阅，此时不再交出帧
+        if (sub->removed.load()) {
+            slot.readers.fetch_sub(1, std::memory_order_release);
+            return LOCK_RESULT_INVALID;
+        }
+        if (slot.sequence < min_sequence) {
+            slot.readers.fetch_sub(1, std::memory_order_release);
+            return LOCK_RESULT_NO_FRAME;
+        }
+
+        info->width = slot.width;
+        info->height = slot.height;
+        info->stride = slot.width * static_cast<uint32_t>(sub->bpp);
+        info->length = static_cast<uint32_t>(slot.data.size());
+        info->format = sub->config.format;
+        info->sequence = slot.sequence;
+        info->timestamp_ns = slot.producer_time_ns;
+        info->data = slot.data.data();
+        info->frame_ref = new SubscriberLock{sub, &slot};
+        if (structSize >= offsetof(FrameInfoEx, lock_time_ns) + sizeof(int64_t)) {
+            info->acquire_time_ns = slot.acquire_time_ns;
+            info->commit_time_ns = slot.commit_time_ns;
+            info->lock_time_ns = MonotonicNowNs();
+        }
+        if (structSize >= offsetof(FrameInfoEx, distance) + sizeof(int32_t)) {
+            info->screen_id = -1;
+            info->distance = -1;
+        }
+        return LOCK_RESULT_OK;
+    }
+    return LOCK_RESULT_NO_FRAME;
+}
+
+BRIDGE_API int UnlockSubscriberFrame(const FrameInfoEx *info) {
+    if (info && info->frame_ref) {
+        auto *handle = static_cast<SubscriberLock *>(info->frame_ref);
+        handle->slot->readers.fetch_sub(1, std::memory_order_release);
+        delete handle;
+    }
+    return 0;
+}
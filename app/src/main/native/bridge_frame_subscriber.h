@@ -0,0 +1,8 @@
+#ifndef BRIDGE_FRAME_SUBSCRIBER_H
+#define BRIDGE_FRAME_SUBSCRIBER_H
+
+#include "bridge_frame_buffer.h"
+
+extern const FrameAnalyzer kFrameSubscriberAnalyzer;
+
+#endif // BRIDGE_FRAME_SUBSCRIBER_H
@@ -1,6 +1,11 @@
 #include <unistd.h>
 #include "bridge_input.h"
 
+#include "bridge_frame_buffer.h"
+#include "bridge_preview_overlay.h"
+
+#include <android/native_window_jni.h>
+
 static JavaVM *g_jvm = nullptr;
 static jclass g_driver_clz = nullptr;
 static jmethodID g_touch_down_method = nullptr;
@@ -9,6 +14,7 @@ static jmethodID g_touch_up_method = nullptr;
 static jmethodID g_key_down_method = nullptr;
 static jmethodID g_key_up_method = nullptr;
 static jmethodID g_start_app_method = nullptr;
+static jmethodID g_capture_surface_method = nullptr;
 
 static int
 UpcallInputControl(JNIEnv *env, MethodType method, int x, int y, int keyCode, int displayId) {
@@ -72,10 +78,13 @@ bool InitInputBridge(JavaVM *vm, JNIEnv *env, const char *driverClassName) {
     g_key_down_method = env->GetStaticMethodID(g_driver_clz, "keyDown", "(II)Z");
     g_key_up_method = env->GetStaticMethodID(g_driver_clz, "keyUp", "(II)Z");
     g_start_app_method = env->GetStaticMethodID(g_driver_clz, "startApp", "(Ljava/lang/String;IZ)Z");
+    g_capture_surface_method = env->GetStaticMethodID(g_driver_clz, "onCaptureSurfaceChanged",
+                                                      "(ILandroid/view/Surface;)Z");
 
     if (CheckJNIException(env, "GetStaticMethodID(DriverClass)") ||
         !g_touch_down_method || !g_touch_move_method || !g_touch_up_method ||
-        !g_key_down_method || !g_key_up_method || !g_start_app_method) {
+        !g_key_down_method || !g_key_up_method || !g_start_app_method ||
+        !g_capture_surface_method) {
         ReleaseInputBridge(env);
         return false;
     }
@@ -90,6 +99,7 @@ void ReleaseInputBridge(JNIEnv *env) {
     g_key_down_method = nullptr;
     g_key_up_method = nullptr;
     g_start_app_method = nullptr;
+    g_capture_surface_method = nullptr;
 
     if (g_driver_clz && env) {
         env->DeleteGlobalRef(g_driver_clz);
@@ -129,6 +139,17 @@ static JNIEnv *GetJNIEnv() {
 
 BRIDGE_API int DispatchInputMessage(MethodParam param) {
     LOGD("DispatchInputMessage: method=%d display_id=%d", param.method, param.display_id);
+#ifdef ENABLE_FRAME_TIMING
+    // 与帧的 producer/commit 时间同为 CLOCK_MONOTONIC，可据此对齐输入与画面
+    LOGI("DispatchInputMessage: method=%d at %lld ns, frame #%lld", param.method,
+         static_cast<long long>(MonotonicNowNs()), static_cast<long long>(GetFrameCount()));
+#endif
+
+    // 预览只显示默认会话，发往其他显示的触摸不画标记
+    if ((param.method == TOUCH_DOWN || param.method == TOUCH_MOVE || param.method == TOUCH_UP) &&
+        IsDefaultDisplay(param.display_id)) {
+        PushPreviewTouch(param.args.touch.p.x, param.args.touch.p.y, param.method);
+    }
 
     auto *env = GetJNIEnv();
     if (!env) {
@@ -157,3 +178,19 @@ BRIDGE_API int DispatchInputMessage(MethodParam param) {
             return 0;
     }
 }
+
+bool UpcallCaptureSurfaceChanged(int display_id, ANativeWindow *window) {
+    auto *env = GetJNIEnv();
+    if (!env || !window || !g_driver_clz || !g_capture_surface_method) {
+        return false;
+    }
+
+    jobject surface = ANativeWindow_toSurface(env, window);
+    if (!surface || CheckJNIException(env, "ANativeWindow_toSurface")) {
+        return false;
+    }
+    jboolean result = env->CallStaticBooleanMethod(g_driver_clz, g_capture_surface_method,
+                                                   display_id, surface);
+    env->DeleteLocalRef(surface);
+    return !CheckJNIException(env, "onCaptureSurfaceChanged") && result;
+}
@@ -3,7 +3,11 @@
 
 #include "bridge_internal.h"
 
+#include <android/native_window.h>
+
 bool InitInputBridge(JavaVM *vm, JNIEnv *env, const char *driverClassName);
 void ReleaseInputBridge(JNIEnv *env);
+// 采集读取器重建后通知 Java 把显示切到新的 Surface
+bool UpcallCaptureSurfaceChanged(int display_id, ANativeWindow *window);
 
 #endif // BRIDGE_INPUT_H
@@ -5,6 +5,8 @@
 
 #include <android/log.h>
 
+#include <chrono>
+
 #define LOG_TAG "LibBridge"
 
 #ifdef NDEBUG
@@ -17,4 +19,9 @@
 #define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
+static inline int64_t MonotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 #endif // BRIDGE_INTERNAL_H
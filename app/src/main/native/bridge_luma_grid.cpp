@@ -0,0 +1,55 @@
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+
+void LumaGridReset(LumaGrid *grid, int src_x, int src_y, int src_w, int src_h,
+                   int grid_w, int grid_h, int step) {
+    // 步长不能超过单个网格的边长，否则会出现采不到样的空格子
+    step = std::min(step, std::min(src_w / std::max(grid_w, 1), src_h / std::max(grid_h, 1)));
+    step = std::max(step, 1);
+
+    if (grid->src_x != src_x || grid->src_w != src_w || grid->grid_w != grid_w ||
+        grid->step != step || grid->col_cell.empty()) {
+        const int samples = (src_w + step - 1) / step;
+        grid->col_cell.resize(static_cast<size_t>(samples));
+        for (int i = 0; i < samples; ++i) {
+            grid->col_cell[i] = static_cast<uint16_t>(
+                    static_cast<int64_t>(i) * step * grid_w / src_w);
+        }
+    }
+
+    grid->src_x = src_x;
+    grid->src_y = src_y;
+    grid->src_w = src_w;
+    grid->src_h = src_h;
+    grid->grid_w = grid_w;
+    grid->grid_h = grid_h;
+    grid->step = step;
+    grid->sums.assign(static_cast<size_t>(grid_w) * grid_h, 0);
+    grid->counts.assign(static_cast<size_t>(grid_w) * grid_h, 0);
+}
+
+void LumaGridAddRow(LumaGrid *grid, int y, const uint8_t *bgr_row) {
+    const int ry = y - grid->src_y;
+    if (ry < 0 || ry >= grid->src_h || ry % grid->step != 0) {
+        return;
+    }
+
+    const int gy = static_cast<int>(static_cast<int64_t>(ry) * grid->grid_h / grid->src_h);
+    uint32_t *sums = grid->sums.data() + static_cast<size_t>(gy) * grid->grid_w;
+    uint32_t *counts = grid->counts.data() + static_cast<size_t>(gy) * grid->grid_w;
+    const uint8_t *p = bgr_row + static_cast<size_t>(grid->src_x) * 3;
+    const size_t advance = static_cast<size_t>(grid->step) * 3;
+    for (uint16_t cell : grid->col_cell) {
+        sums[cell] += BgrToLuma(p);
+        counts[cell] += 1;
+        p += advance;
+    }
+}
+
+void LumaGridResolve(const LumaGrid *grid, uint8_t *out) {
+    const size_t cells = grid->sums.size();
+    for (size_t i = 0; i < cells; ++i) {
+        out[i] = grid->counts[i] ? static_cast<uint8_t>(grid->sums[i] / grid->counts[i]) : 0;
+    }
+}
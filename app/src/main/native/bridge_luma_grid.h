@@ -0,0 +1,31 @@
+#ifndef BRIDGE_LUMA_GRID_H
+#define BRIDGE_LUMA_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 按固定步长抽样，把源区域内的 BGR 行累加为 grid_w x grid_h 的亮度均值网格
+struct LumaGrid {
+    int src_x = 0;
+    int src_y = 0;
+    int src_w = 0;
+    int src_h = 0;
+    int grid_w = 0;
+    int grid_h = 0;
+    int step = 1;
+    std::vector<uint16_t> col_cell;
+    std::vector<uint32_t> sums;
+    std::vector<uint32_t> counts;
+};
+
+static inline uint32_t BgrToLuma(const uint8_t *bgr) {
+    return (bgr[0] * 29u + bgr[1] * 150u + bgr[2] * 77u) >> 8;
+}
+
+void LumaGridReset(LumaGrid *grid, int src_x, int src_y, int src_w, int src_h,
+                   int grid_w, int grid_h, int step);
+void LumaGridAddRow(LumaGrid *grid, int y, const uint8_t *bgr_row);
+void LumaGridResolve(const LumaGrid *grid, uint8_t *out);
+
+#endif // BRIDGE_LUMA_GRID_H
@@ -0,0 +1,254 @@
+#include "bridge_motion.h"
+
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define MOTION_GRID_WIDTH 128
+#define MOTION_GRID_HEIGHT 72
+#define MOTION_SAMPLE_STEP 4
+// 虚拟屏画面不变时不出帧，超过该时长没有新帧即视为静止
+#define MOTION_IDLE_MS 200
+
+struct MotionWatch {
+    int id;
+    RoiRect rect;
+    float threshold;
+    MotionSettledCallback callback;
+    void *user;
+    bool settled;
+};
+
+struct FiredWatch {
+    int id;
+    float energy;
+    MotionSettledCallback callback;
+    void *user;
+};
+
+// 正在执行的回调，RemoveMotionWatch 据此等待其返回
+struct FiringWatch {
+    int id;
+    std::thread::id thread;
+};
+
+static LumaGrid g_motionGrid;
+
+static std::mutex g_motionMutex;
+static uint8_t g_prevLuma[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+static uint8_t g_diff[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+static bool g_hasPrev = false;
+static int g_frameWidth = 0;
+static int g_frameHeight = 0;
+static int64_t g_lastFrameNs = 0;
+static std::vector<MotionWatch> g_watches;
+static int g_nextWatchId = 1;
+static std::vector<FiringWatch> g_firing;
+static std::condition_variable g_firingCv;
+// 动画结束后虚拟屏不再出帧，最后一帧的差值可能仍高于阈值；由定时线程在无帧满 MOTION_IDLE_MS
+// 后按静止处理，与 GetRegionMotion 的规则一致。定时线程常驻，进程退出时仍在等待，条件变量不析构
+static std::condition_variable &g_idleCv = *new std::condition_variable();
+static std::once_flag g_idleThreadOnce;
+
+static float RegionEnergyLocked(const RoiRect &rect) {
+    if (!g_hasPrev || g_frameWidth <= 0 || g_frameHeight <= 0) {
+        return 0;
+    }
+
+    const int x0 = std::max(rect.x, 0);
+    const int y0 = std::max(rect.y, 0);
+    const int x1 = std::min(rect.x + rect.width, g_frameWidth);
+    const int y1 = std::min(rect.y + rect.height, g_frameHeight);
+    if (x1 <= x0 || y1 <= y0) {
+        return 0;
+    }
+
+    const int gx0 = x0 * MOTION_GRID_WIDTH / g_frameWidth;
+    const int gy0 = y0 * MOTION_GRID_HEIGHT / g_frameHeight;
+    const int gx1 = std::max(gx0 + 1, (x1 * MOTION_GRID_WIDTH + g_frameWidth - 1) / g_frameWidth);
+    const int gy1 = std::max(gy0 + 1,
+                             (y1 * MOTION_GRID_HEIGHT + g_frameHeight - 1) / g_frameHeight);
+    uint32_t sum = 0;
+    for (int gy = gy0; gy < gy1; ++gy) {
+        for (int gx = gx0; gx < gx1; ++gx) {
+            sum += g_diff[gy * MOTION_GRID_WIDTH + gx];
+        }
+    }
+    return static_cast<float>(sum) / static_cast<float>((gx1 - gx0) * (gy1 - gy0));
+}
+
+// 调用时持有 lock，回调期间释放；已被移除的监视不再回调
+static void FireWatchesLocked(std::unique_lock<std::mutex> &lock,
+                              const std::vector<FiredWatch> &fired) {
+    const std::thread::id self = std::this_thread::get_id();
+    for (const FiredWatch &watch : fired) {
+        const bool registered = std::any_of(g_watches.begin(), g_watches.end(),
+                                            [&watch](const MotionWatch &w) {
+                                                return w.id == watch.id;
+                                            });
+        if (!registered) {
+            continue;
+        }
+        g_firing.push_back(FiringWatch{watch.id, self});
+        lock.unlock();
+        watch.callback(watch.id, watch.energy, watch.user);
+        lock.lock();
+        for (auto it = g_firing.begin(); it != g_firing.end(); ++it) {
+            if (it->id == watch.id && it->thread == self) {
+                g_firing.erase(it);
+                break;
+            }
+        }
+        g_firingCv.notify_all();
+    }
+}
+
+static bool HasUnsettledWatchLocked() {
+    return std::any_of(g_watches.begin(), g_watches.end(),
+                       [](const MotionWatch &w) { return !w.settled; });
+}
+
+static void MotionIdleLoop() {
+    const int64_t idleNs = static_cast<int64_t>(MOTION_IDLE_MS) * 1000000;
+    std::unique_lock<std::mutex> lock(g_motionMutex);
+    while (true) {
+        if (!g_hasPrev || !HasUnsettledWatchLocked()) {
+            g_idleCv.wait(lock);
+            continue;
+        }
+        const int64_t remainNs = g_lastFrameNs + idleNs - MonotonicNowNs();
+        if (remainNs > 0) {
+            g_idleCv.wait_for(lock, std::chrono::nanoseconds(remainNs));
+            continue;
+        }
+
+        std::vector<FiredWatch> fired;
+        for (MotionWatch &watch : g_watches) {
+            if (!watch.settled) {
+                watch.settled = true;
+                fired.push_back(FiredWatch{watch.id, 0, watch.callback, watch.user});
+            }
+        }
+        FireWatchesLocked(lock, fired);
+    }
+}
+
+static bool BeginMotion(const FrameBuffer *frame) {
+    LumaGridReset(&g_motionGrid, 0, 0, frame->width, frame->height,
+                  MOTION_GRID_WIDTH, MOTION_GRID_HEIGHT, MOTION_SAMPLE_STEP);
+    return true;
+}
+
+static void AccumulateMotionRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    (void) frame;
+    LumaGridAddRow(&g_motionGrid, y, bgr);
+}
+
+static void CommitMotion(const FrameBuffer *frame) {
+    uint8_t luma[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+    LumaGridResolve(&g_motionGrid, luma);
+
+    std::vector<FiredWatch> fired;
+    std::unique_lock<std::mutex> lock(g_motionMutex);
+    {
+        const bool sizeChanged = g_frameWidth != frame->width || g_frameHeight != frame->height;
+        for (int i = 0; i < MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT; ++i) {
+            g_diff[i] = g_hasPrev && !sizeChanged
+                        ? static_cast<uint8_t>(std::abs(luma[i] - g_prevLuma[i])) : 0;
+            g_prevLuma[i] = luma[i];
+        }
+        g_hasPrev = true;
+        g_frameWidth = frame->width;
+        g_frameHeight = frame->height;
+        g_lastFrameNs = MonotonicNowNs();
+
+        for (MotionWatch &watch : g_watches) {
+            const float energy = RegionEnergyLocked(watch.rect);
+            const bool settled = energy < watch.threshold;
+            if (settled && !watch.settled) {
+                fired.push_back(FiredWatch{watch.id, energy, watch.callback, watch.user});
+            }
+            watch.settled = settled;
+        }
+    }
+    if (HasUnsettledWatchLocked()) {
+        g_idleCv.notify_one();
+    }
+
+    // 回调在采集线程执行，且不持锁，回调内可以调用查询或移除接口
+    FireWatchesLocked(lock, fired);
+}
+
+static void ReleaseMotion() {
+    std::lock_guard<std::mutex> lock(g_motionMutex);
+    g_hasPrev = false;
+    g_frameWidth = 0;
+    g_frameHeight = 0;
+    g_lastFrameNs = 0;
+    for (MotionWatch &watch : g_watches) {
+        watch.settled = false;
+    }
+}
+
+const FrameAnalyzer kMotionAnalyzer = {
+        BeginMotion,
+        AccumulateMotionRow,
+        CommitMotion,
+        ReleaseMotion,
+};
+
+BRIDGE_API int GetRegionMotion(const RoiRect *rects, uint32_t count, float *energy) {
+    if (!rects || !energy) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(g_motionMutex);
+    if (!g_hasPrev) {
+        return -1;
+    }
+    const bool idle = MonotonicNowNs() - g_lastFrameNs >= static_cast<int64_t>(MOTION_IDLE_MS) * 1000000;
+    for (uint32_t i = 0; i < count; ++i) {
+        energy[i] = idle ? 0 : RegionEnergyLocked(rects[i]);
+    }
+    return static_cast<int>(count);
+}
+
+BRIDGE_API int AddMotionWatch(const RoiRect *rect, float threshold,
+                              MotionSettledCallback callback, void *user) {
+    if (!rect || !callback) {
+        return -1;
+    }
+
+    std::call_once(g_idleThreadOnce, [] { std::thread(MotionIdleLoop).detach(); });
+    std::lock_guard<std::mutex> lock(g_motionMutex);
+    const int id = g_nextWatchId++;
+    g_watches.push_back(MotionWatch{id, *rect, threshold, callback, user, false});
+    g_idleCv.notify_one();
+    return id;
+}
+
+BRIDGE_API int RemoveMotionWatch(int watch_id) {
+    std::unique_lock<std::mutex> lock(g_motionMutex);
+    auto it = std::find_if(g_watches.begin(), g_watches.end(),
+                           [watch_id](const MotionWatch &w) { return w.id == watch_id; });
+    if (it == g_watches.end()) {
+        return -1;
+    }
+    g_watches.erase(it);
+
+    // 等其他线程上正在执行的回调返回，之后调用方即可释放 user；回调内移除自身时不等待
+    const std::thread::id self = std::this_thread::get_id();
+    auto inFlight = [watch_id, self](const FiringWatch &f) {
+        return f.id == watch_id && f.thread != self;
+    };
+    g_firingCv.wait(lock, [&inFlight] {
+        return std::none_of(g_firing.begin(), g_firing.end(), inFlight);
+    });
+    return 0;
+}
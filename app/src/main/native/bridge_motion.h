@@ -0,0 +1,8 @@
+#ifndef BRIDGE_MOTION_H
+#define BRIDGE_MOTION_H
+
+#include "bridge_frame_buffer.h"
+
+extern const FrameAnalyzer kMotionAnalyzer;
+
+#endif // BRIDGE_MOTION_H
@@ -0,0 +1,265 @@
+#include "bridge_pixel_convert.h"
+
+#include <media/NdkImage.h>
+
+#include <cstddef>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+int CaptureFormatToImageFormat(CapturePixelFormat format) {
+    switch (format) {
+        case CAPTURE_FORMAT_RGBX_8888:
+            return AIMAGE_FORMAT_RGBX_8888;
+        case CAPTURE_FORMAT_RGB_565:
+            return AIMAGE_FORMAT_RGB_565;
+        case CAPTURE_FORMAT_YUV_420_888:
+            return AIMAGE_FORMAT_YUV_420_888;
+        case CAPTURE_FORMAT_RGBA_8888:
+        default:
+            return AIMAGE_FORMAT_RGBA_8888;
+    }
+}
+
+bool IsValidCaptureFormat(int format) {
+    return format >= CAPTURE_FORMAT_RGBA_8888 && format <= CAPTURE_FORMAT_YUV_420_888;
+}
+
+static inline uint8_t Clamp8(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// BT.601 limited range，6 位定点，亮度系数 74.5 拆成 74k + (k >> 1)；
+// SIMD 版本用 int16 饱和加减，只有结果本就大于 255 时才会饱和，与标量逐位一致
+static inline void YuvToBgrPixel(int y, int u, int v, uint8_t *d) {
+    const int yy = (y - 16) * 74 + ((y - 16) >> 1) + 32;
+    const int du = u - 128;
+    const int dv = v - 128;
+    d[0] = Clamp8((yy + 129 * du) >> 6);
+    d[1] = Clamp8((yy - (25 * du + 52 * dv)) >> 6);
+    d[2] = Clamp8((yy + 102 * dv) >> 6);
+}
+
+#if !defined(__ARM_NEON) && defined(__SSSE3__)
+// 把 8 个 int16 的 B/G/R 饱和打包并交织写出 24 字节
+static inline void StoreBgr8Ssse3(__m128i b16, __m128i g16, __m128i r16, uint8_t *d) {
+    const __m128i bg = _mm_unpacklo_epi8(_mm_packus_epi16(b16, b16), _mm_packus_epi16(g16, g16));
+    const __m128i r = _mm_packus_epi16(r16, r16);
+    const __m128i out0 = _mm_or_si128(
+            _mm_shuffle_epi8(bg, _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10)),
+            _mm_shuffle_epi8(r, _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1)));
+    const __m128i out1 = _mm_or_si128(
+            _mm_shuffle_epi8(bg, _mm_setr_epi8(11, -1, 12, 13, -1, 14, 15, -1,
+                                               -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(r, _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7,
+                                              -1, -1, -1, -1, -1, -1, -1, -1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d), out0);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(d + 16), out1);
+}
+#endif
+
+// RGBA 与 RGBX 布局相同，忽略第 4 字节
+static void ConvertRowRgbaToBgr(const uint8_t *__restrict s, uint8_t *__restrict d3, int width) {
+    int x = 0;
+
+#if defined(__ARM_NEON)
+    for (; x <= width - 16; x += 16) {
+        uint8x16x4_t rgba = vld4q_u8(s);
+        s += 64;
+        uint8x16x3_t bgr;
+        bgr.val[0] = rgba.val[2];
+        bgr.val[1] = rgba.val[1];
+        bgr.val[2] = rgba.val[0];
+        vst3q_u8(d3, bgr);
+        d3 += 48;
+    }
+    for (; x <= width - 8; x += 8) {
+        uint8x8x4_t rgba = vld4_u8(s);
+        s += 32;
+        uint8x8x3_t bgr;
+        bgr.val[0] = rgba.val[2];
+        bgr.val[1] = rgba.val[1];
+        bgr.val[2] = rgba.val[0];
+        vst3_u8(d3, bgr);
+        d3 += 24;
+    }
+#elif defined(__SSSE3__)
+    // 每次写 16 字节、有效 12 字节，多出的 4 字节由下一次覆盖，留足 6 像素余量避免越过行尾
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    for (; x + 6 <= width; x += 4) {
+        const __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d3), _mm_shuffle_epi8(rgba, shuffle));
+        s += 16;
+        d3 += 12;
+    }
+#endif
+    for (; x < width; ++x) {
+        d3[0] = s[2];
+        d3[1] = s[1];
+        d3[2] = s[0];
+        s += 4;
+        d3 += 3;
+    }
+}
+
+// R 在高 5 位，按位复制把 5/6 位扩展到 8 位
+static void ConvertRowRgb565ToBgr(const uint8_t *__restrict s, uint8_t *__restrict d3, int width) {
+    int x = 0;
+
+#if defined(__ARM_NEON)
+    for (; x <= width - 8; x += 8) {
+        const uint16x8_t p = vreinterpretq_u16_u8(vld1q_u8(s));
+        s += 16;
+        const uint8x8_t r = vshrn_n_u16(p, 8);
+        const uint8x8_t g = vshrn_n_u16(p, 3);
+        const uint8x8_t b = vmovn_u16(vshlq_n_u16(p, 3));
+        uint8x8x3_t bgr;
+        bgr.val[0] = vorr_u8(b, vshr_n_u8(b, 5));
+        bgr.val[1] = vorr_u8(vand_u8(g, vdup_n_u8(0xFC)), vshr_n_u8(g, 6));
+        bgr.val[2] = vorr_u8(vand_u8(r, vdup_n_u8(0xF8)), vshr_n_u8(r, 5));
+        vst3_u8(d3, bgr);
+        d3 += 24;
+    }
+#elif defined(__SSSE3__)
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    for (; x <= width - 8; x += 8) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        s += 16;
+        const __m128i r5 = _mm_srli_epi16(p, 11);
+        const __m128i g6 = _mm_and_si128(_mm_srli_epi16(p, 5), mask6);
+        const __m128i b5 = _mm_and_si128(p, mask5);
+        StoreBgr8Ssse3(_mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2)),
+                       _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4)),
+                       _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2)),
+                       d3);
+        d3 += 24;
+    }
+#endif
+    for (; x < width; ++x) {
+        const int p = s[0] | (s[1] << 8);
+        const int r5 = p >> 11;
+        const int g6 = (p >> 5) & 0x3F;
+        const int b5 = p & 0x1F;
+        d3[0] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+        d3[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+        d3[2] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+        s += 2;
+        d3 += 3;
+    }
+}
+
+#if defined(__ARM_NEON)
+static inline uint8x8x3_t YuvToBgr8Neon(uint8x8_t y, uint8x8_t u, uint8x8_t v) {
+    const int16x8_t k = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(16));
+    const int16x8_t yy = vaddq_s16(vmlaq_n_s16(vshrq_n_s16(k, 1), k, 74), vdupq_n_s16(32));
+    const int16x8_t du = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+    const int16x8_t dv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+    uint8x8x3_t bgr;
+    bgr.val[0] = vqshrun_n_s16(vqaddq_s16(yy, vmulq_n_s16(du, 129)), 6);
+    bgr.val[1] = vqshrun_n_s16(vqsubq_s16(yy, vmlaq_n_s16(vmulq_n_s16(du, 25), dv, 52)), 6);
+    bgr.val[2] = vqshrun_n_s16(vqaddq_s16(yy, vmulq_n_s16(dv, 102)), 6);
+    return bgr;
+}
+#endif
+
+// 半平面 YUV，uv 每两个像素共享一对色度；vu_order 为 NV21
+static void ConvertRowNv12ToBgr(const uint8_t *__restrict y, const uint8_t *__restrict uv,
+                                uint8_t *__restrict d3, int width, bool vu_order) {
+    int x = 0;
+
+#if defined(__ARM_NEON)
+    for (; x <= width - 16; x += 16) {
+        const uint8x16_t yv = vld1q_u8(y + x);
+        const uint8x8x2_t c = vld2_u8(uv + x);
+        const uint8x8_t u = vu_order ? c.val[1] : c.val[0];
+        const uint8x8_t v = vu_order ? c.val[0] : c.val[1];
+        const uint8x8x2_t uu = vzip_u8(u, u);
+        const uint8x8x2_t vv = vzip_u8(v, v);
+        vst3_u8(d3, YuvToBgr8Neon(vget_low_u8(yv), uu.val[0], vv.val[0]));
+        vst3_u8(d3 + 24, YuvToBgr8Neon(vget_high_u8(yv), uu.val[1], vv.val[1]));
+        d3 += 48;
+    }
+#elif defined(__SSSE3__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i k16 = _mm_set1_epi16(16);
+    const __m128i k32 = _mm_set1_epi16(32);
+    const __m128i k128 = _mm_set1_epi16(128);
+    const __m128i k74 = _mm_set1_epi16(74);
+    const __m128i k129 = _mm_set1_epi16(129);
+    const __m128i k25 = _mm_set1_epi16(25);
+    const __m128i k52 = _mm_set1_epi16(52);
+    const __m128i k102 = _mm_set1_epi16(102);
+    // 每个色度字节复制给相邻两个像素，并零扩展为 int16
+    const __m128i evenMask = _mm_setr_epi8(0, -1, 0, -1, 2, -1, 2, -1, 4, -1, 4, -1, 6, -1, 6, -1);
+    const __m128i oddMask = _mm_setr_epi8(1, -1, 1, -1, 3, -1, 3, -1, 5, -1, 5, -1, 7, -1, 7, -1);
+    const __m128i uMask = vu_order ? oddMask : evenMask;
+    const __m128i vMask = vu_order ? evenMask : oddMask;
+    for (; x <= width - 8; x += 8) {
+        const __m128i y8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + x));
+        const __m128i c = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(uv + x));
+        const __m128i k = _mm_sub_epi16(_mm_unpacklo_epi8(y8, zero), k16);
+        const __m128i yy = _mm_add_epi16(
+                _mm_add_epi16(_mm_mullo_epi16(k, k74), _mm_srai_epi16(k, 1)), k32);
+        const __m128i du = _mm_sub_epi16(_mm_shuffle_epi8(c, uMask), k128);
+        const __m128i dv = _mm_sub_epi16(_mm_shuffle_epi8(c, vMask), k128);
+        const __m128i gTerm = _mm_add_epi16(_mm_mullo_epi16(du, k25), _mm_mullo_epi16(dv, k52));
+        StoreBgr8Ssse3(_mm_srai_epi16(_mm_adds_epi16(yy, _mm_mullo_epi16(du, k129)), 6),
+                       _mm_srai_epi16(_mm_subs_epi16(yy, gTerm), 6),
+                       _mm_srai_epi16(_mm_adds_epi16(yy, _mm_mullo_epi16(dv, k102)), 6),
+                       d3);
+        d3 += 24;
+    }
+#endif
+    const int uOffset = vu_order ? 1 : 0;
+    for (; x < width; ++x) {
+        const uint8_t *c = uv + (x & ~1);
+        YuvToBgrPixel(y[x], c[uOffset], c[1 - uOffset], d3);
+        d3 += 3;
+    }
+}
+
+// 任意像素步长的 YUV_420_888（如 I420），只走标量
+static void ConvertRowYuvPlanarToBgr(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                     int u_step, int v_step, uint8_t *__restrict d3, int width) {
+    for (int x = 0; x < width; ++x) {
+        const int cx = x >> 1;
+        YuvToBgrPixel(y[x], u[cx * u_step], v[cx * v_step], d3);
+        d3 += 3;
+    }
+}
+
+void ConvertSourceRowToBgr(const FrameSource *src, int y, uint8_t *__restrict dst, int width) {
+    const uint8_t *row = src->planes[0] + static_cast<size_t>(y) * src->row_stride[0];
+    switch (src->format) {
+        case CAPTURE_FORMAT_RGB_565:
+            ConvertRowRgb565ToBgr(row, dst, width);
+            return;
+        case CAPTURE_FORMAT_YUV_420_888: {
+            const size_t cy = static_cast<size_t>(y >> 1);
+            const uint8_t *u = src->planes[1] + cy * src->row_stride[1];
+            const uint8_t *v = src->planes[2] + cy * src->row_stride[2];
+            if (src->pixel_stride[1] == 2 && src->pixel_stride[2] == 2) {
+                if (v == u + 1) {
+                    ConvertRowNv12ToBgr(row, u, dst, width, false);
+                    return;
+                }
+                if (u == v + 1) {
+                    ConvertRowNv12ToBgr(row, v, dst, width, true);
+                    return;
+                }
+            }
+            ConvertRowYuvPlanarToBgr(row, u, v, src->pixel_stride[1], src->pixel_stride[2],
+                                     dst, width);
+            return;
+        }
+        case CAPTURE_FORMAT_RGBA_8888:
+        case CAPTURE_FORMAT_RGBX_8888:
+        default:
+            ConvertRowRgbaToBgr(row, dst, width);
+            return;
+    }
+}
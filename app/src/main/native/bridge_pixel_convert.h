@@ -0,0 +1,28 @@
+#ifndef BRIDGE_PIXEL_CONVERT_H
+#define BRIDGE_PIXEL_CONVERT_H
+
+#include <cstdint>
+
+// 采集格式，取值与 Java 侧 NativeBridgeLib.CAPTURE_FORMAT_* 一致
+enum CapturePixelFormat {
+    CAPTURE_FORMAT_RGBA_8888 = 0,
+    CAPTURE_FORMAT_RGBX_8888 = 1,
+    CAPTURE_FORMAT_RGB_565 = 2,
+    CAPTURE_FORMAT_YUV_420_888 = 3,
+};
+
+// 一帧源数据的平面描述；YUV 为 Y/U/V 三个平面，其余格式只用 planes[0]
+struct FrameSource {
+    CapturePixelFormat format;
+    const uint8_t *planes[3];
+    int row_stride[3];
+    int pixel_stride[3];
+};
+
+int CaptureFormatToImageFormat(CapturePixelFormat format);
+bool IsValidCaptureFormat(int format);
+
+// 把第 y 行转换为 BGR888
+void ConvertSourceRowToBgr(const FrameSource *src, int y, uint8_t *__restrict dst, int width);
+
+#endif // BRIDGE_PIXEL_CONVERT_H
@@ -0,0 +1,145 @@
+#include "bridge_frame_buffer.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define PROBE_BATCH 16
+
+struct ProbeBatch {
+    alignas(16) uint8_t b[PROBE_BATCH];
+    alignas(16) uint8_t g[PROBE_BATCH];
+    alignas(16) uint8_t r[PROBE_BATCH];
+    alignas(16) uint8_t expect_b[PROBE_BATCH];
+    alignas(16) uint8_t expect_g[PROBE_BATCH];
+    alignas(16) uint8_t expect_r[PROBE_BATCH];
+    alignas(16) uint8_t tolerance[PROBE_BATCH];
+    uint32_t valid;
+};
+
+static void GatherProbes(const FrameBuffer *frame, const PixelProbe *probes, int count,
+                         ProbeBatch *batch) {
+    batch->valid = 0;
+    for (int i = 0; i < PROBE_BATCH; ++i) {
+        batch->b[i] = batch->g[i] = batch->r[i] = 0;
+        batch->expect_b[i] = batch->expect_g[i] = batch->expect_r[i] = 0xFF;
+        batch->tolerance[i] = 0;
+        if (i >= count) {
+            continue;
+        }
+
+        const PixelProbe &probe = probes[i];
+        if (probe.x < 0 || probe.y < 0 || probe.x >= frame->width || probe.y >= frame->height) {
+            continue;
+        }
+        const uint8_t *px = frame->bgr_data +
+                            (static_cast<size_t>(probe.y) * frame->width + probe.x) * 3;
+        batch->b[i] = px[0];
+        batch->g[i] = px[1];
+        batch->r[i] = px[2];
+        batch->expect_b[i] = probe.b;
+        batch->expect_g[i] = probe.g;
+        batch->expect_r[i] = probe.r;
+        batch->tolerance[i] = probe.tolerance;
+        batch->valid |= 1u << i;
+    }
+}
+
+// 三通道差的最大值不超过 tolerance 即为命中，返回 16 位命中掩码
+static uint32_t MatchProbeBatch(const ProbeBatch *batch) {
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t db = vabdq_u8(vld1q_u8(batch->b), vld1q_u8(batch->expect_b));
+    uint8x16_t dg = vabdq_u8(vld1q_u8(batch->g), vld1q_u8(batch->expect_g));
+    uint8x16_t dr = vabdq_u8(vld1q_u8(batch->r), vld1q_u8(batch->expect_r));
+    uint8x16_t hit = vcleq_u8(vmaxq_u8(db, vmaxq_u8(dg, dr)), vld1q_u8(batch->tolerance));
+    static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(hit, vld1q_u8(kBits));
+    uint32_t mask = vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8);
+#elif defined(__SSE2__)
+    auto absDiff = [](const uint8_t *a, const uint8_t *b) {
+        __m128i va = _mm_load_si128(reinterpret_cast<const __m128i *>(a));
+        __m128i vb = _mm_load_si128(reinterpret_cast<const __m128i *>(b));
+        return _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+    };
+    __m128i diff = _mm_max_epu8(absDiff(batch->b, batch->expect_b),
+                                _mm_max_epu8(absDiff(batch->g, batch->expect_g),
+                                             absDiff(batch->r, batch->expect_r)));
+    __m128i tol = _mm_load_si128(reinterpret_cast<const __m128i *>(batch->tolerance));
+    __m128i over = _mm_subs_epu8(diff, tol);
+    uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(over, _mm_setzero_si128())));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < PROBE_BATCH; ++i) {
+        int db = batch->b[i] > batch->expect_b[i] ? batch->b[i] - batch->expect_b[i]
+                                                  : batch->expect_b[i] - batch->b[i];
+        int dg = batch->g[i] > batch->expect_g[i] ? batch->g[i] - batch->expect_g[i]
+                                                  : batch->expect_g[i] - batch->g[i];
+        int dr = batch->r[i] > batch->expect_r[i] ? batch->r[i] - batch->expect_r[i]
+                                                  : batch->expect_r[i] - batch->r[i];
+        if (db <= batch->tolerance[i] && dg <= batch->tolerance[i] && dr <= batch->tolerance[i]) {
+            mask |= 1u << i;
+        }
+    }
+#endif
+    return mask & batch->valid;
+}
+
+static bool MatchProbe(const FrameBuffer *frame, const PixelProbe &probe) {
+    if (probe.x < 0 || probe.y < 0 || probe.x >= frame->width || probe.y >= frame->height) {
+        return false;
+    }
+    const uint8_t *px = frame->bgr_data +
+                        (static_cast<size_t>(probe.y) * frame->width + probe.x) * 3;
+    const int expect[3] = {probe.b, probe.g, probe.r};
+    for (int c = 0; c < 3; ++c) {
+        int d = px[c] - expect[c];
+        if (d < -probe.tolerance || d > probe.tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BRIDGE_API int ProbePixels(const PixelProbe *probes, uint32_t count, uint32_t *result_mask) {
+    if (!probes || !result_mask) {
+        return -1;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return -1;
+    }
+    if (!frame->bgr_data) {
+        UnlockFrame(frame);
+        return -1;
+    }
+
+    for (uint32_t w = 0; w < (count + 31) / 32; ++w) {
+        result_mask[w] = 0;
+    }
+
+    int hits = 0;
+    uint32_t i = 0;
+    // 少量探针直接逐个比较，凑够一批才走向量化
+    if (count >= PROBE_BATCH) {
+        ProbeBatch batch;
+        for (; i + PROBE_BATCH <= count; i += PROBE_BATCH) {
+            GatherProbes(frame, probes + i, PROBE_BATCH, &batch);
+            uint32_t mask = MatchProbeBatch(&batch);
+            result_mask[i / 32] |= mask << (i % 32);
+            hits += __builtin_popcount(mask);
+        }
+    }
+    for (; i < count; ++i) {
+        if (MatchProbe(frame, probes[i])) {
+            result_mask[i / 32] |= 1u << (i % 32);
+            ++hits;
+        }
+    }
+
+    UnlockFrame(frame);
+    return hits;
+}
@@ -1,4 +1,7 @@
 #include "bridge_preview.h"
+#include "bridge_frame_buffer.h"
+#include "bridge_preview_blit.h"
+#include "bridge_preview_overlay.h"
 
 #include <android/hardware_buffer.h>
 #include <android/native_window.h>
@@ -10,11 +13,14 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
+#include <cstring>
 #include <mutex>
-#include <queue>
 #include <thread>
 
 static PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC eglGetNativeClientBufferANDROID = nullptr;
@@ -27,10 +33,41 @@ struct EGLState {
     EGLSurface surface = EGL_NO_SURFACE;
     EGLContext context = EGL_NO_CONTEXT;
     GLuint program = 0;
-    GLuint textureId = 0;
+    GLuint tapProgram = 0;
+    GLuint downProgram = 0;
+    GLint tapOffsetLoc = -1;
+    GLint downOffsetLoc = -1;
+    GLuint vertexBuffer = 0;
+    GLint positionLoc = -1;
+    GLint texCoordLoc = -1;
+    GLuint fbo = 0;
+    GLuint fboTexture = 0;
+    int fboWidth = 0;
+    int fboHeight = 0;
     bool initialized = false;
 };
 
+// 交织的顶点坐标与纹理坐标，一次性上传到 VBO
+static const GLfloat kQuadVertices[] = {
+        -1, 1, 0, 0,
+        -1, -1, 0, 1,
+        1, 1, 1, 0,
+        1, -1, 1, 1,
+};
+
+// AImageReader 只在少量固定的 AHardwareBuffer 间轮转，按缓冲区缓存 EGLImage 和绑定好的纹理，
+// 避免每帧创建、销毁 EGLImage；读取器重建或缓冲区被移除时整体作废
+struct CachedImage {
+    AHardwareBuffer *buffer = nullptr;
+    EGLImageKHR image = EGL_NO_IMAGE_KHR;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+    uint64_t last_used = 0;
+};
+
+static constexpr int kImageCacheSize = 8;
+
 static const char *VERTEX_SHADER = R"(
 attribute vec4 vPosition;
 attribute vec2 vTexCoord;
@@ -51,18 +88,105 @@ void main() {
 }
 )";
 
+// 缩小超过 2 倍时双线性只覆盖 2x2 纹素会闪烁；4 个双线性采样点相距半个目标像素，覆盖约 4x4 纹素
+static const char *TAP_FRAGMENT_SHADER = R"(
+#extension GL_OES_EGL_image_external : require
+precision mediump float;
+uniform samplerExternalOES sTexture;
+uniform vec2 uTapOffset;
+varying vec2 fTexCoord;
+void main() {
+    vec2 d = vec2(uTapOffset.x, -uTapOffset.y);
+    gl_FragColor = 0.25 * (texture2D(sTexture, fTexCoord - uTapOffset) +
+                           texture2D(sTexture, fTexCoord + uTapOffset) +
+                           texture2D(sTexture, fTexCoord + d) +
+                           texture2D(sTexture, fTexCoord - d));
+}
+)";
+
+// 第二级从中间 FBO 采样，FBO 内容上下颠倒
+static const char *DOWN_FRAGMENT_SHADER = R"(
+precision mediump float;
+uniform sampler2D sTexture;
+uniform vec2 uTapOffset;
+varying vec2 fTexCoord;
+void main() {
+    vec2 uv = vec2(fTexCoord.x, 1.0 - fTexCoord.y);
+    vec2 d = vec2(uTapOffset.x, -uTapOffset.y);
+    gl_FragColor = 0.25 * (texture2D(sTexture, uv - uTapOffset) +
+                           texture2D(sTexture, uv + uTapOffset) +
+                           texture2D(sTexture, uv + d) +
+                           texture2D(sTexture, uv - d));
+}
+)";
+
+// 单次 4 点采样能覆盖的最大缩小倍数，超过时先缩到源尺寸的 1/4 再缩到目标尺寸
+static constexpr float kBilinearMaxRatio = 2.0f;
+static constexpr float kTapMaxRatio = 4.0f;
+
 static jobject g_previewSurfaceObj = nullptr;
 static std::mutex g_previewMutex;
 static std::atomic<bool> g_hasPreview{false};
 
 static EGLState g_eglState;
 static std::thread g_renderThread;
-static std::queue<AImage *> g_renderQueue;
-static std::mutex g_renderMutex;
-static std::condition_variable g_renderCv;
+// 单槽信箱，只保留最新一帧，内容是 AHardwareBuffer_acquire 得到的引用。
+// 采集线程只做一次原子交换，槽位由空变满时才写 eventfd 唤醒渲染线程，不与渲染线程争锁
+static std::atomic<AHardwareBuffer *> g_previewMailbox{nullptr};
+static int g_renderEventFd = -1;
 static std::atomic<bool> g_renderThreadRunning{false};
+// 仅保护窗口交接，采集线程不会获取
+static std::mutex g_renderMutex;
 static ANativeWindow *g_pendingWindow = nullptr;
 
+// 预览节奏由渲染线程控制：两次绘制间至少相隔一个目标间隔，期间到达的帧相互替换只画最新的；
+// 交换间隔为 1，呈现对齐到 vsync。0 表示不限速，仅受 vsync 约束
+static constexpr uint32_t kDefaultPreviewFps = 60;
+static constexpr uint32_t kMaxPreviewFps = 120;
+static std::atomic<int64_t> g_previewIntervalNs{1000000000LL / kDefaultPreviewFps};
+// EGL 初始化失败时改用 ANativeWindow_lock 逐像素写入，CPU 开销大，限制在 10fps 以内
+static constexpr int64_t kCpuFallbackIntervalNs = 100000000LL;
+// 超过该时长没有新帧时释放 EGL 上下文、表面和缓存，线程停在 eventfd 上，下一帧到达时再初始化；
+// 0 表示一直保留。默认取 60s，远长于 MAA 界面常见的静止时段，重建的首帧延迟见
+// PreviewStats.first_frame_last_ns；客户端按设置下发
+static constexpr uint32_t kDefaultPreviewIdleTimeoutMs = 60000;
+static std::atomic<int64_t> g_previewIdleTimeoutNs{kDefaultPreviewIdleTimeoutMs * 1000000LL};
+// 预览被遮挡或隐藏时不接收也不绘制帧，采集侧也不再分发
+static std::atomic<bool> g_previewVisible{true};
+
+// offered / replaced / throttled 由采集线程更新，其余只由渲染线程写入
+struct PreviewCounters {
+    std::atomic<int64_t> frames_offered{0};
+    std::atomic<int64_t> frames_replaced{0};
+    std::atomic<int64_t> frames_throttled{0};
+    std::atomic<int64_t> frames_rendered{0};
+    std::atomic<int64_t> redraws{0};
+    std::atomic<int64_t> render_last_ns{0};
+    std::atomic<int64_t> render_max_ns{0};
+    std::atomic<int64_t> render_total_ns{0};
+    std::atomic<int64_t> swap_last_ns{0};
+    std::atomic<int64_t> swap_max_ns{0};
+    std::atomic<int64_t> swap_total_ns{0};
+    std::atomic<int64_t> latency_last_ns{0};
+    std::atomic<int64_t> latency_max_ns{0};
+    std::atomic<int64_t> latency_total_ns{0};
+    std::atomic<int64_t> backend_inits{0};
+    std::atomic<int64_t> first_frame_last_ns{0};
+};
+
+static PreviewCounters g_previewCounters;
+static std::atomic<int> g_previewBackend{PREVIEW_BACKEND_NONE};
+// 渲染线程处于帧率限制的等待中，此时被替换的帧记为 throttled
+static std::atomic<bool> g_previewPacing{false};
+// 信箱中帧的 producer 时间；与缓冲区不是原子的一对，竞争时可能取到更新一帧的时间，只影响统计
+static std::atomic<int64_t> g_previewMailboxTimestampNs{0};
+
+// 缓存只在渲染线程访问，其他线程通过递增 generation 请求清空
+static CachedImage g_imageCache[kImageCacheSize];
+static uint64_t g_imageCacheTick = 0;
+static uint32_t g_imageCacheSeenGeneration = 0;
+static std::atomic<uint32_t> g_imageCacheGeneration{0};
+
 static GLuint LoadShader(GLenum type, const char *source) {
     GLuint shader = glCreateShader(type);
     glShaderSource(shader, 1, &source, nullptr);
@@ -70,11 +194,121 @@ static GLuint LoadShader(GLenum type, const char *source) {
     return shader;
 }
 
-static void DrainPreviewQueueLocked() {
-    while (!g_renderQueue.empty()) {
-        AImage_delete(g_renderQueue.front());
-        g_renderQueue.pop();
+// 单写者，max 无需 CAS
+static void RecordDuration(std::atomic<int64_t> &last, std::atomic<int64_t> &max,
+                           std::atomic<int64_t> &total, int64_t value) {
+    last.store(value, std::memory_order_relaxed);
+    if (value > max.load(std::memory_order_relaxed)) {
+        max.store(value, std::memory_order_relaxed);
+    }
+    total.fetch_add(value, std::memory_order_relaxed);
+}
+
+// producer_ns 为 0 表示重绘最近一帧，不计入延迟
+static void RecordPresent(int64_t render_ns, int64_t swap_ns, int64_t producer_ns,
+                          int64_t presented_ns) {
+    PreviewCounters &counters = g_previewCounters;
+    RecordDuration(counters.render_last_ns, counters.render_max_ns, counters.render_total_ns,
+                   render_ns);
+    RecordDuration(counters.swap_last_ns, counters.swap_max_ns, counters.swap_total_ns, swap_ns);
+    if (!producer_ns) {
+        counters.redraws.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    counters.frames_rendered.fetch_add(1, std::memory_order_relaxed);
+    if (presented_ns > producer_ns) {
+        RecordDuration(counters.latency_last_ns, counters.latency_max_ns,
+                       counters.latency_total_ns, presented_ns - producer_ns);
+    }
+}
+
+static void WakeRenderThread() {
+    if (g_renderEventFd >= 0) {
+        const uint64_t one = 1;
+        write(g_renderEventFd, &one, sizeof(one));
+    }
+}
+
+// timeout_ms 为 -1 时一直等待
+static void WaitRenderEvent(int timeout_ms) {
+    pollfd pfd = {g_renderEventFd, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) > 0 && (pfd.revents & POLLIN)) {
+        uint64_t value = 0;
+        read(g_renderEventFd, &value, sizeof(value));
+    }
+}
+
+static void ReleaseCachedImage(CachedImage *entry) {
+    if (entry->texture) {
+        glDeleteTextures(1, &entry->texture);
+    }
+    if (entry->image != EGL_NO_IMAGE_KHR && eglDestroyImageKHR) {
+        eglDestroyImageKHR(g_eglState.display, entry->image);
+    }
+    *entry = CachedImage();
+}
+
+// 需在上下文为当前时调用
+static void ReleaseImageCache() {
+    for (CachedImage &entry : g_imageCache) {
+        if (entry.buffer) {
+            ReleaseCachedImage(&entry);
+        }
+    }
+}
+
+static CachedImage *AcquireCachedImage(AHardwareBuffer *hb, bool *created) {
+    const uint32_t generation = g_imageCacheGeneration.load(std::memory_order_acquire);
+    if (generation != g_imageCacheSeenGeneration) {
+        ReleaseImageCache();
+        g_imageCacheSeenGeneration = generation;
+    }
+
+    *created = false;
+    CachedImage *victim = &g_imageCache[0];
+    for (CachedImage &entry : g_imageCache) {
+        if (entry.buffer == hb) {
+            entry.last_used = ++g_imageCacheTick;
+            return &entry;
+        }
+        if (!entry.buffer) {
+            victim = &entry;
+        } else if (victim->buffer && entry.last_used < victim->last_used) {
+            victim = &entry;
+        }
     }
+    if (victim->buffer) {
+        ReleaseCachedImage(victim);
+    }
+
+    EGLClientBuffer clientBuffer = eglGetNativeClientBufferANDROID(hb);
+    EGLint attrs[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+    EGLImageKHR image = eglCreateImageKHR(g_eglState.display, EGL_NO_CONTEXT,
+                                          EGL_NATIVE_BUFFER_ANDROID, clientBuffer, attrs);
+    if (image == EGL_NO_IMAGE_KHR) {
+        LOGE("RenderPreview: eglCreateImageKHR failed");
+        return nullptr;
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture);
+    glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, image);
+
+    AHardwareBuffer_Desc desc = {};
+    AHardwareBuffer_describe(hb, &desc);
+    victim->buffer = hb;
+    victim->image = image;
+    victim->texture = texture;
+    victim->width = static_cast<int>(desc.width);
+    victim->height = static_cast<int>(desc.height);
+    victim->last_used = ++g_imageCacheTick;
+    *created = true;
+    return victim;
 }
 
 static void DeinitEGL() {
@@ -86,11 +320,22 @@ static void DeinitEGL() {
         if (g_eglState.surface != EGL_NO_SURFACE && g_eglState.context != EGL_NO_CONTEXT) {
             eglMakeCurrent(g_eglState.display, g_eglState.surface, g_eglState.surface,
                            g_eglState.context);
-            if (g_eglState.textureId) {
-                glDeleteTextures(1, &g_eglState.textureId);
+            ReleaseImageCache();
+            ReleasePreviewOverlay(true);
+            if (g_eglState.fbo) {
+                glDeleteFramebuffers(1, &g_eglState.fbo);
+            }
+            if (g_eglState.fboTexture) {
+                glDeleteTextures(1, &g_eglState.fboTexture);
             }
-            if (g_eglState.program) {
-                glDeleteProgram(g_eglState.program);
+            if (g_eglState.vertexBuffer) {
+                glDeleteBuffers(1, &g_eglState.vertexBuffer);
+            }
+            for (GLuint program : {g_eglState.program, g_eglState.tapProgram,
+                                   g_eglState.downProgram}) {
+                if (program) {
+                    glDeleteProgram(program);
+                }
             }
         }
         eglMakeCurrent(g_eglState.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
@@ -106,11 +351,185 @@ static void DeinitEGL() {
     g_eglState.display = EGL_NO_DISPLAY;
     g_eglState.surface = EGL_NO_SURFACE;
     g_eglState.context = EGL_NO_CONTEXT;
+    // 上下文销毁后纹理和 EGLImage 随之失效
+    for (CachedImage &entry : g_imageCache) {
+        entry = CachedImage();
+    }
+    ReleasePreviewOverlay(false);
     g_eglState.program = 0;
-    g_eglState.textureId = 0;
+    g_eglState.tapProgram = 0;
+    g_eglState.downProgram = 0;
+    g_eglState.tapOffsetLoc = -1;
+    g_eglState.downOffsetLoc = -1;
+    g_eglState.fbo = 0;
+    g_eglState.fboTexture = 0;
+    g_eglState.fboWidth = 0;
+    g_eglState.fboHeight = 0;
+    g_eglState.vertexBuffer = 0;
+    g_eglState.positionLoc = -1;
+    g_eglState.texCoordLoc = -1;
     g_eglState.initialized = false;
 }
 
+// 所有预览程序共用顶点着色器和 VBO，固定占用 0、1 号属性，叠加层使用其余位置
+static GLuint BuildPreviewProgram(const char *fragmentSource) {
+    GLuint vShader = LoadShader(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fShader = LoadShader(GL_FRAGMENT_SHADER, fragmentSource);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vShader);
+    glAttachShader(program, fShader);
+    glBindAttribLocation(program, 0, "vPosition");
+    glBindAttribLocation(program, 1, "vTexCoord");
+    glLinkProgram(program);
+    glDeleteShader(vShader);
+    glDeleteShader(fShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "sTexture"), 0);
+    return program;
+}
+
+// 程序、VBO 和 attribute / uniform 位置只在初始化时准备一次，要求上下文已为当前
+static bool InitPreviewGL() {
+    GLuint program = BuildPreviewProgram(FRAGMENT_SHADER);
+    if (!program) {
+        LOGE("InitPreviewGL: program link failed");
+        return false;
+    }
+    g_eglState.program = program;
+    g_eglState.positionLoc = 0;
+    g_eglState.texCoordLoc = 1;
+
+    // 多点采样程序不可用时退回双线性，只是大倍数缩小时画质差一些
+    g_eglState.tapProgram = BuildPreviewProgram(TAP_FRAGMENT_SHADER);
+    g_eglState.downProgram = BuildPreviewProgram(DOWN_FRAGMENT_SHADER);
+    if (g_eglState.tapProgram) {
+        g_eglState.tapOffsetLoc = glGetUniformLocation(g_eglState.tapProgram, "uTapOffset");
+    }
+    if (g_eglState.downProgram) {
+        g_eglState.downOffsetLoc = glGetUniformLocation(g_eglState.downProgram, "uTapOffset");
+    }
+
+    glGenBuffers(1, &g_eglState.vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, g_eglState.vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(kQuadVertices), kQuadVertices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(g_eglState.positionLoc);
+    glVertexAttribPointer(g_eglState.positionLoc, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat),
+                          reinterpret_cast<const void *>(0));
+    glEnableVertexAttribArray(g_eglState.texCoordLoc);
+    glVertexAttribPointer(g_eglState.texCoordLoc, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat),
+                          reinterpret_cast<const void *>(2 * sizeof(GLfloat)));
+    glActiveTexture(GL_TEXTURE0);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    // 叠加层不可用时只是不画标记，不影响预览本身
+    if (!InitPreviewOverlay()) {
+        LOGW("InitPreviewGL: overlay unavailable");
+    }
+    return true;
+}
+
+// 中间 FBO 尺寸随源分辨率变化时重建
+static bool EnsureDownscaleTarget(int width, int height) {
+    if (g_eglState.fbo && g_eglState.fboWidth == width && g_eglState.fboHeight == height) {
+        return true;
+    }
+    if (!g_eglState.fboTexture) {
+        glGenTextures(1, &g_eglState.fboTexture);
+    }
+    if (!g_eglState.fbo) {
+        glGenFramebuffers(1, &g_eglState.fbo);
+    }
+    glBindTexture(GL_TEXTURE_2D, g_eglState.fboTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindFramebuffer(GL_FRAMEBUFFER, g_eglState.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           g_eglState.fboTexture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+        LOGE("EnsureDownscaleTarget: framebuffer incomplete %dx%d", width, height);
+        g_eglState.fboWidth = 0;
+        g_eglState.fboHeight = 0;
+        return false;
+    }
+    g_eglState.fboWidth = width;
+    g_eglState.fboHeight = height;
+    return true;
+}
+
+// 4 点采样的偏移为缩小倍数的 1/4 个源纹素
+static void SetTapOffset(GLint location, float ratio, int srcWidth, int srcHeight) {
+    const float texels = ratio * 0.25f;
+    glUniform2f(location, texels / static_cast<float>(srcWidth),
+                texels / static_cast<float>(srcHeight));
+}
+
+// 等比适配到表面并居中，其余部分为黑边；缩小倍数按需选择双线性、单级或两级 4 点采样
+static void DrawFrameQuad(GLuint texture, int frameWidth, int frameHeight) {
+    EGLint surfaceWidth = 0;
+    EGLint surfaceHeight = 0;
+    eglQuerySurface(g_eglState.display, g_eglState.surface, EGL_WIDTH, &surfaceWidth);
+    eglQuerySurface(g_eglState.display, g_eglState.surface, EGL_HEIGHT, &surfaceHeight);
+    if (surfaceWidth <= 0 || surfaceHeight <= 0 || frameWidth <= 0 || frameHeight <= 0) {
+        return;
+    }
+
+    const float scale = std::min(static_cast<float>(surfaceWidth) / frameWidth,
+                                 static_cast<float>(surfaceHeight) / frameHeight);
+    const int viewWidth = std::max(1, static_cast<int>(frameWidth * scale + 0.5f));
+    const int viewHeight = std::max(1, static_cast<int>(frameHeight * scale + 0.5f));
+    const int viewX = (surfaceWidth - viewWidth) / 2;
+    const int viewY = (surfaceHeight - viewHeight) / 2;
+    const float ratio = 1.0f / scale;
+
+    glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture);
+    if (ratio > kTapMaxRatio && g_eglState.tapProgram && g_eglState.downProgram) {
+        const int midWidth = std::max(1, static_cast<int>(frameWidth / kTapMaxRatio));
+        const int midHeight = std::max(1, static_cast<int>(frameHeight / kTapMaxRatio));
+        if (EnsureDownscaleTarget(midWidth, midHeight)) {
+            glBindFramebuffer(GL_FRAMEBUFFER, g_eglState.fbo);
+            glViewport(0, 0, midWidth, midHeight);
+            glUseProgram(g_eglState.tapProgram);
+            SetTapOffset(g_eglState.tapOffsetLoc, kTapMaxRatio, frameWidth, frameHeight);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            glViewport(0, 0, surfaceWidth, surfaceHeight);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glViewport(viewX, viewY, viewWidth, viewHeight);
+            glBindTexture(GL_TEXTURE_2D, g_eglState.fboTexture);
+            glUseProgram(g_eglState.downProgram);
+            SetTapOffset(g_eglState.downOffsetLoc, static_cast<float>(midWidth) / viewWidth,
+                         midWidth, midHeight);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            return;
+        }
+    }
+
+    glViewport(0, 0, surfaceWidth, surfaceHeight);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glViewport(viewX, viewY, viewWidth, viewHeight);
+    if (ratio > kBilinearMaxRatio && g_eglState.tapProgram) {
+        glUseProgram(g_eglState.tapProgram);
+        SetTapOffset(g_eglState.tapOffsetLoc, std::min(ratio, kTapMaxRatio), frameWidth,
+                     frameHeight);
+    } else {
+        glUseProgram(g_eglState.program);
+    }
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
 static bool InitEGL(ANativeWindow *window) {
     DeinitEGL();
 
@@ -160,6 +579,7 @@ static bool InitEGL(ANativeWindow *window) {
         eglTerminate(display);
         return false;
     }
+    eglSwapInterval(display, 1);
 
     eglGetNativeClientBufferANDROID = reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
             eglGetProcAddress("eglGetNativeClientBufferANDROID"));
@@ -170,36 +590,22 @@ static bool InitEGL(ANativeWindow *window) {
     glEGLImageTargetTexture2DOES = reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
             eglGetProcAddress("glEGLImageTargetTexture2DOES"));
 
-    GLuint vShader = LoadShader(GL_VERTEX_SHADER, VERTEX_SHADER);
-    GLuint fShader = LoadShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vShader);
-    glAttachShader(program, fShader);
-    glLinkProgram(program);
-    glDeleteShader(vShader);
-    glDeleteShader(fShader);
-    glUseProgram(program);
-
-    GLuint textureId = 0;
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, textureId);
-    glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
     g_eglState.display = display;
     g_eglState.surface = surface;
     g_eglState.context = context;
-    g_eglState.program = program;
-    g_eglState.textureId = textureId;
     g_eglState.initialized = true;
+    g_imageCacheSeenGeneration = g_imageCacheGeneration.load(std::memory_order_acquire);
 
-    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    // 上下文此后一直保持在渲染线程上，每帧只需绑定纹理、绘制和交换
+    if (!InitPreviewGL()) {
+        DeinitEGL();
+        return false;
+    }
     return true;
 }
 
-static void RenderPreview(AHardwareBuffer *hb) {
+// producer_ns 为 0 表示重绘
+static void RenderPreview(AHardwareBuffer *hb, int64_t producer_ns) {
     if (!g_eglState.initialized || !hb) {
         return;
     }
@@ -208,85 +614,224 @@ static void RenderPreview(AHardwareBuffer *hb) {
         return;
     }
 
-    if (eglMakeCurrent(g_eglState.display, g_eglState.surface, g_eglState.surface,
-                       g_eglState.context) == EGL_FALSE) {
-        LOGE("RenderPreview: eglMakeCurrent failed, error=0x%x", eglGetError());
+    const int64_t renderStart = MonotonicNowNs();
+    bool created = false;
+    CachedImage *cached = AcquireCachedImage(hb, &created);
+    if (!cached) {
         return;
     }
+    // 叠加层沿用画面所在的视口，帧坐标直接对应
+    DrawFrameQuad(cached->texture, cached->width, cached->height);
+    DrawPreviewOverlay(cached->width, cached->height);
+    const int64_t swapStart = MonotonicNowNs();
+    eglSwapBuffers(g_eglState.display, g_eglState.surface);
+    const int64_t swapEnd = MonotonicNowNs();
+    RecordPresent(swapStart - renderStart, swapEnd - swapStart, producer_ns, swapEnd);
+#ifdef ENABLE_FRAME_TIMING
+    LOGI("preview render %.2fms swap %.2fms (image cache %s)", (swapStart - renderStart) / 1e6,
+         (swapEnd - swapStart) / 1e6, created ? "miss" : "hit");
+#endif
+}
 
-    EGLClientBuffer clientBuffer = eglGetNativeClientBufferANDROID(hb);
-    EGLint attrs[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
-    EGLImageKHR image = eglCreateImageKHR(g_eglState.display, EGL_NO_CONTEXT,
-                                          EGL_NATIVE_BUFFER_ANDROID, clientBuffer, attrs);
-    if (image == EGL_NO_IMAGE_KHR) {
-        LOGE("RenderPreview: eglCreateImageKHR failed");
-        eglMakeCurrent(g_eglState.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-        return;
+static bool LockNativeWindow(void *ctx, BlitTarget *target) {
+    auto *window = static_cast<ANativeWindow *>(ctx);
+    ANativeWindow_Buffer buffer;
+    if (ANativeWindow_lock(window, &buffer, nullptr) != 0) {
+        return false;
     }
+    if (buffer.format != WINDOW_FORMAT_RGBA_8888 && buffer.format != WINDOW_FORMAT_RGBX_8888) {
+        LOGE("BlitPreview: unsupported window format %d", buffer.format);
+        ANativeWindow_unlockAndPost(window);
+        return false;
+    }
+    target->pixels = static_cast<uint32_t *>(buffer.bits);
+    target->width = buffer.width;
+    target->height = buffer.height;
+    target->stride = buffer.stride;
+    return true;
+}
 
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, g_eglState.textureId);
-    glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, image);
+static void PostNativeWindow(void *ctx) {
+    ANativeWindow_unlockAndPost(static_cast<ANativeWindow *>(ctx));
+}
 
-    glClear(GL_COLOR_BUFFER_BIT);
-    GLfloat vertices[] = {-1, 1, -1, -1, 1, 1, 1, -1};
-    GLfloat texCoords[] = {0, 0, 0, 1, 1, 0, 1, 1};
+static const BlitWindowOps kNativeWindowOps = {LockNativeWindow, PostNativeWindow};
 
-    GLint posLoc = glGetAttribLocation(g_eglState.program, "vPosition");
-    GLint texLoc = glGetAttribLocation(g_eglState.program, "vTexCoord");
+// 窗口尚未被 EGL 连接，可以直接改为 CPU 写入
+static bool EnableCpuFallback(ANativeWindow *window) {
+    if (ANativeWindow_setBuffersGeometry(window, 0, 0, WINDOW_FORMAT_RGBX_8888) != 0) {
+        LOGE("EnableCpuFallback: setBuffersGeometry failed");
+        return false;
+    }
+    LOGW("preview falling back to CPU blit");
+    return true;
+}
 
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(posLoc, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-    glEnableVertexAttribArray(texLoc);
-    glVertexAttribPointer(texLoc, 2, GL_FLOAT, GL_FALSE, 0, texCoords);
+// 画面取自采集线程已转换好的默认 BGR 帧，不触碰硬件缓冲区
+static void BlitPreview(ANativeWindow *window) {
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return;
+    }
+    const int64_t blitStart = MonotonicNowNs();
+    const bool posted = BlitFrameToWindow(&kNativeWindowOps, window, frame->bgr_data,
+                                          frame->width, frame->height, frame->width * 3);
+    const int64_t blitEnd = MonotonicNowNs();
+    if (posted) {
+        RecordPresent(blitEnd - blitStart, 0, frame->producer_time_ns, blitEnd);
+    }
+#ifdef ENABLE_FRAME_TIMING
+    LOGI("preview blit %.2fms", (blitEnd - blitStart) / 1e6);
+#endif
+    UnlockFrame(frame);
+}
 
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    eglSwapBuffers(g_eglState.display, g_eglState.surface);
+// 按计划时间推进，避免逐帧累积漂移；落后时从本次绘制重新计时
+static void ScheduleNextRender(int64_t *nextRenderNs, int64_t renderStart, int64_t interval) {
+    *nextRenderNs += interval;
+    if (*nextRenderNs < renderStart) {
+        *nextRenderNs = renderStart + interval;
+    }
+}
 
-    eglDestroyImageKHR(g_eglState.display, image);
-    eglMakeCurrent(g_eglState.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+// 从取到第一帧开始计时，包含 EGL 初始化、纹理创建和第一次交换
+static void LogFirstPreviewFrame(int64_t *startNs, int64_t now, const char *path) {
+    if (*startNs) {
+        g_previewCounters.first_frame_last_ns.store(now - *startNs, std::memory_order_relaxed);
+        LOGI("preview first frame in %.2fms (%s)", (now - *startNs) / 1e6, path);
+        *startNs = 0;
+    }
 }
 
 static void RenderLoop() {
     ANativeWindow *window = nullptr;
+    // 最近绘制的缓冲区，画面静止时用它重绘以推进叠加层动画
+    AHardwareBuffer *lastBuffer = nullptr;
+    int64_t nextRenderNs = 0;
+    bool cpuFallback = false;
+    // EGL 在窗口交接和空闲释放后都推迟到下一帧到达时初始化
+    bool initPending = false;
+    int64_t lastRenderNs = 0;
+    // 非 0 时表示正在等待初始化后的第一帧画面，记录开始初始化的时间
+    int64_t firstFrameStartNs = 0;
 
     while (g_renderThreadRunning.load(std::memory_order_acquire)) {
-        AImage *image = nullptr;
         {
-            std::unique_lock<std::mutex> lock(g_renderMutex);
-            g_renderCv.wait(lock, [] {
-                return !g_renderThreadRunning.load(std::memory_order_acquire) ||
-                       !g_renderQueue.empty() || g_pendingWindow != nullptr;
-            });
-
-            if (!g_renderThreadRunning.load(std::memory_order_acquire)) {
-                break;
-            }
-
+            std::lock_guard<std::mutex> lock(g_renderMutex);
             if (g_pendingWindow) {
                 if (window) {
                     ANativeWindow_release(window);
                 }
                 window = g_pendingWindow;
                 g_pendingWindow = nullptr;
-                InitEGL(window);
+                DeinitEGL();
+                g_previewBackend.store(PREVIEW_BACKEND_NONE, std::memory_order_relaxed);
+                cpuFallback = false;
+                initPending = true;
             }
+        }
+
+        // 读取器重建后旧缓冲区不再重绘；缓存的 EGLImage 同时释放，不等下一帧到达，
+        // 否则画面静止时最多 8 个旧缓冲区会一直被引用。上下文始终在本线程保持为当前
+        const uint32_t generation = g_imageCacheGeneration.load(std::memory_order_acquire);
+        if (generation != g_imageCacheSeenGeneration) {
+            if (lastBuffer) {
+                AHardwareBuffer_release(lastBuffer);
+                lastBuffer = nullptr;
+            }
+            if (g_eglState.initialized) {
+                ReleaseImageCache();
+            }
+            g_imageCacheSeenGeneration = generation;
+        }
 
-            if (!g_renderQueue.empty()) {
-                image = g_renderQueue.front();
-                g_renderQueue.pop();
+        // 信箱为空且无动画时等待唤醒；未到下一次绘制时间则限时等待，期间的新帧在信箱中相互替换。
+        // 不可见时动画不绘制，也不按帧率唤醒
+        const bool hasFrame = g_previewMailbox.load(std::memory_order_acquire) != nullptr;
+        const bool animating = lastBuffer && IsPreviewOverlayAnimating() &&
+                               g_previewVisible.load(std::memory_order_acquire);
+        if (!hasFrame && !animating) {
+            const int64_t idleTimeout = g_previewIdleTimeoutNs.load(std::memory_order_relaxed);
+            if (!g_eglState.initialized || idleTimeout <= 0) {
+                WaitRenderEvent(-1);
+                continue;
+            }
+            const int64_t idleFor = MonotonicNowNs() - lastRenderNs;
+            if (idleFor < idleTimeout) {
+                WaitRenderEvent(static_cast<int>((idleTimeout - idleFor + 999999) / 1000000));
+                continue;
             }
+            LOGI("preview idle for %lldms, releasing EGL", static_cast<long long>(idleFor / 1000000));
+            if (lastBuffer) {
+                AHardwareBuffer_release(lastBuffer);
+                lastBuffer = nullptr;
+            }
+            DeinitEGL();
+            g_previewBackend.store(PREVIEW_BACKEND_NONE, std::memory_order_relaxed);
+            initPending = true;
+            continue;
+        }
+        const int64_t now = MonotonicNowNs();
+        if (now < nextRenderNs) {
+            g_previewPacing.store(true, std::memory_order_relaxed);
+            WaitRenderEvent(static_cast<int>((nextRenderNs - now + 999999) / 1000000));
+            g_previewPacing.store(false, std::memory_order_relaxed);
+            continue;
         }
 
-        if (image) {
-            AHardwareBuffer *hb = nullptr;
-            if (AImage_getHardwareBuffer(image, &hb) == AMEDIA_OK && hb) {
-                RenderPreview(hb);
+        AHardwareBuffer *hb = g_previewMailbox.exchange(nullptr, std::memory_order_acq_rel);
+        const int64_t timestampNs =
+                hb ? g_previewMailboxTimestampNs.load(std::memory_order_relaxed) : 0;
+        if (hb && initPending) {
+            initPending = false;
+            firstFrameStartNs = MonotonicNowNs();
+            const bool egl = InitEGL(window);
+            cpuFallback = !egl && EnableCpuFallback(window);
+            g_previewBackend.store(egl ? PREVIEW_BACKEND_EGL : cpuFallback ? PREVIEW_BACKEND_CPU
+                                                                           : PREVIEW_BACKEND_NONE,
+                                   std::memory_order_relaxed);
+            g_previewCounters.backend_inits.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (hb && cpuFallback) {
+            // 回退模式下信箱只用作新帧通知
+            AHardwareBuffer_release(hb);
+            const int64_t renderStart = MonotonicNowNs();
+            if (g_previewVisible.load(std::memory_order_acquire)) {
+                BlitPreview(window);
+            }
+            lastRenderNs = MonotonicNowNs();
+            LogFirstPreviewFrame(&firstFrameStartNs, lastRenderNs, "cpu");
+            ScheduleNextRender(&nextRenderNs, renderStart,
+                               std::max(g_previewIntervalNs.load(std::memory_order_relaxed),
+                                        kCpuFallbackIntervalNs));
+            continue;
+        }
+        if (hb) {
+            if (lastBuffer) {
+                AHardwareBuffer_release(lastBuffer);
+            }
+            lastBuffer = hb;
+        } else if (hasFrame) {
+            // 已被清空
+            continue;
+        }
+        if (lastBuffer) {
+            const int64_t renderStart = MonotonicNowNs();
+            if (g_previewVisible.load(std::memory_order_acquire)) {
+                RenderPreview(lastBuffer, timestampNs);
             }
-            AImage_delete(image);
+            lastRenderNs = MonotonicNowNs();
+            LogFirstPreviewFrame(&firstFrameStartNs, lastRenderNs, "egl");
+            ScheduleNextRender(&nextRenderNs, renderStart,
+                               g_previewIntervalNs.load(std::memory_order_relaxed));
         }
     }
 
+    if (lastBuffer) {
+        AHardwareBuffer_release(lastBuffer);
+    }
     DeinitEGL();
+    g_previewBackend.store(PREVIEW_BACKEND_NONE, std::memory_order_relaxed);
     if (window) {
         ANativeWindow_release(window);
     }
@@ -300,16 +845,16 @@ void SetPreviewSurface(JNIEnv *env, jobject jSurface) {
     }
 
     if (g_renderThreadRunning.load(std::memory_order_acquire)) {
-        g_renderThreadRunning.store(false, std::memory_order_release);
-        g_renderCv.notify_all();
+        g_renderThreadRunning.store(false);
+        WakeRenderThread();
         if (g_renderThread.joinable()) {
             g_renderThread.join();
         }
     }
 
+    DrainPreviewQueue();
     {
-        std::lock_guard<std::mutex> queueLock(g_renderMutex);
-        DrainPreviewQueueLocked();
+        std::lock_guard<std::mutex> windowLock(g_renderMutex);
         if (g_pendingWindow) {
             ANativeWindow_release(g_pendingWindow);
             g_pendingWindow = nullptr;
@@ -324,10 +869,18 @@ void SetPreviewSurface(JNIEnv *env, jobject jSurface) {
     if (jSurface && env) {
         g_previewSurfaceObj = env->NewGlobalRef(jSurface);
         ANativeWindow *window = ANativeWindow_fromSurface(env, jSurface);
+        if (window && g_renderEventFd < 0) {
+            g_renderEventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (g_renderEventFd < 0) {
+                LOGE("SetPreviewSurface: eventfd failed");
+                ANativeWindow_release(window);
+                window = nullptr;
+            }
+        }
         if (window) {
-            g_renderThreadRunning.store(true, std::memory_order_release);
+            g_renderThreadRunning.store(true);
             {
-                std::lock_guard<std::mutex> queueLock(g_renderMutex);
+                std::lock_guard<std::mutex> windowLock(g_renderMutex);
                 g_pendingWindow = window;
             }
             g_renderThread = std::thread(RenderLoop);
@@ -342,42 +895,112 @@ void SetPreviewSurface(JNIEnv *env, jobject jSurface) {
 }
 
 bool IsPreviewEnabled() {
-    return g_hasPreview.load(std::memory_order_acquire);
+    return g_hasPreview.load(std::memory_order_acquire) &&
+           g_previewVisible.load(std::memory_order_acquire);
 }
 
-bool DispatchPreview(AImage *image) {
-    if (!image || !g_renderThreadRunning.load(std::memory_order_acquire)) {
-        return false;
+void SetPreviewFrameRate(uint32_t fps) {
+    if (fps > kMaxPreviewFps) {
+        fps = kMaxPreviewFps;
     }
+    g_previewIntervalNs.store(fps ? 1000000000LL / fps : 0, std::memory_order_relaxed);
+    LOGI("SetPreviewFrameRate: %u fps", fps);
+}
 
-    static auto lastDispatchTime = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration_cast<std::chrono::milliseconds>(now - lastDispatchTime).count() <
-        16) {
+void SetPreviewIdleTimeout(uint32_t timeout_ms) {
+    g_previewIdleTimeoutNs.store(static_cast<int64_t>(timeout_ms) * 1000000LL,
+                                 std::memory_order_relaxed);
+    // 让正在等待的渲染线程按新时长重新计时
+    RequestPreviewRedraw();
+    LOGI("SetPreviewIdleTimeout: %ums", timeout_ms);
+}
+
+void SetPreviewVisible(bool visible) {
+    g_previewVisible.store(visible, std::memory_order_release);
+    if (!visible) {
+        DrainPreviewQueue();
+    } else {
+        // 恢复可见时唤醒渲染线程，继续未结束的动画
+        RequestPreviewRedraw();
+    }
+    LOGI("SetPreviewVisible: %d", visible);
+}
+
+bool DispatchPreview(AHardwareBuffer *buffer, int64_t timestamp_ns) {
+    if (!buffer || !g_renderThreadRunning.load(std::memory_order_acquire) ||
+        !g_previewVisible.load(std::memory_order_acquire)) {
         return false;
     }
-    lastDispatchTime = now;
 
-    AImage *imageToDelete = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(g_renderMutex);
-        if (!g_renderThreadRunning.load(std::memory_order_acquire)) {
-            return false;
-        }
-        if (!g_renderQueue.empty()) {
-            imageToDelete = g_renderQueue.front();
-            g_renderQueue.pop();
+    g_previewCounters.frames_offered.fetch_add(1, std::memory_order_relaxed);
+    AHardwareBuffer_acquire(buffer);
+    g_previewMailboxTimestampNs.store(timestamp_ns, std::memory_order_relaxed);
+    AHardwareBuffer *replaced = g_previewMailbox.exchange(buffer);
+    if (replaced) {
+        AHardwareBuffer_release(replaced);
+        g_previewCounters.frames_replaced.fetch_add(1, std::memory_order_relaxed);
+        if (g_previewPacing.load(std::memory_order_relaxed)) {
+            g_previewCounters.frames_throttled.fetch_add(1, std::memory_order_relaxed);
         }
-        g_renderQueue.push(image);
+    } else {
+        WakeRenderThread();
     }
-    if (imageToDelete) {
-        AImage_delete(imageToDelete);
+    // 与 SetPreviewSurface 停止线程后的清空交错时，由这里收回，保证引用不会滞留在信箱中
+    if (!g_renderThreadRunning.load()) {
+        DrainPreviewQueue();
+        return false;
     }
-    g_renderCv.notify_one();
     return true;
 }
 
+void RequestPreviewRedraw() {
+    if (g_renderThreadRunning.load(std::memory_order_acquire)) {
+        WakeRenderThread();
+    }
+}
+
 void DrainPreviewQueue() {
-    std::lock_guard<std::mutex> lock(g_renderMutex);
-    DrainPreviewQueueLocked();
+    AHardwareBuffer *pending = g_previewMailbox.exchange(nullptr);
+    if (pending) {
+        AHardwareBuffer_release(pending);
+    }
+}
+
+void InvalidatePreviewImageCache() {
+    g_imageCacheGeneration.fetch_add(1, std::memory_order_acq_rel);
+    // 唤醒空闲的渲染线程释放缓存
+    RequestPreviewRedraw();
+}
+
+BRIDGE_API int GetPreviewStats(PreviewStats *stats) {
+    if (!stats || stats->struct_size < sizeof(uint32_t)) {
+        return -1;
+    }
+
+    const PreviewCounters &counters = g_previewCounters;
+    PreviewStats snapshot{};
+    snapshot.frames_offered = counters.frames_offered.load(std::memory_order_relaxed);
+    snapshot.frames_replaced = counters.frames_replaced.load(std::memory_order_relaxed);
+    snapshot.frames_throttled = counters.frames_throttled.load(std::memory_order_relaxed);
+    snapshot.frames_rendered = counters.frames_rendered.load(std::memory_order_relaxed);
+    snapshot.redraws = counters.redraws.load(std::memory_order_relaxed);
+    snapshot.render_last_ns = counters.render_last_ns.load(std::memory_order_relaxed);
+    snapshot.render_max_ns = counters.render_max_ns.load(std::memory_order_relaxed);
+    snapshot.render_total_ns = counters.render_total_ns.load(std::memory_order_relaxed);
+    snapshot.swap_last_ns = counters.swap_last_ns.load(std::memory_order_relaxed);
+    snapshot.swap_max_ns = counters.swap_max_ns.load(std::memory_order_relaxed);
+    snapshot.swap_total_ns = counters.swap_total_ns.load(std::memory_order_relaxed);
+    snapshot.latency_last_ns = counters.latency_last_ns.load(std::memory_order_relaxed);
+    snapshot.latency_max_ns = counters.latency_max_ns.load(std::memory_order_relaxed);
+    snapshot.latency_total_ns = counters.latency_total_ns.load(std::memory_order_relaxed);
+    snapshot.backend_inits = counters.backend_inits.load(std::memory_order_relaxed);
+    snapshot.first_frame_last_ns = counters.first_frame_last_ns.load(std::memory_order_relaxed);
+    snapshot.backend = g_previewBackend.load(std::memory_order_relaxed);
+    snapshot.visible = IsPreviewEnabled() ? 1 : 0;
+
+    // 按调用方声明的大小拷贝，旧版本结构体只拿到前面的字段
+    const uint32_t structSize = stats->struct_size;
+    snapshot.struct_size = static_cast<uint32_t>(std::min<size_t>(structSize, sizeof(PreviewStats)));
+    memcpy(stats, &snapshot, snapshot.struct_size);
+    return 0;
 }
@@ -3,11 +3,23 @@
 
 #include "bridge_internal.h"
 
-#include <media/NdkImage.h>
+#include <android/hardware_buffer.h>
 
 void SetPreviewSurface(JNIEnv *env, jobject jSurface);
 bool IsPreviewEnabled();
-bool DispatchPreview(AImage *image);
+// 预览目标帧率，0 为仅受 vsync 限制；低功耗悬浮窗可设为 2-5
+void SetPreviewFrameRate(uint32_t fps);
+// 渲染线程空闲多久后释放 EGL 资源，下一帧到达时重新初始化；0 表示不释放
+void SetPreviewIdleTimeout(uint32_t timeout_ms);
+// 预览被遮挡时置为 false，此时不再分发和绘制帧
+void SetPreviewVisible(bool visible);
+// 预览自行持有缓冲区引用，调用方可以立即删除对应的 AImage；
+// timestamp_ns 为帧的 producer 时间，用于统计采集到呈现的延迟
+bool DispatchPreview(AHardwareBuffer *buffer, int64_t timestamp_ns);
 void DrainPreviewQueue();
+// 叠加层内容变化时唤醒渲染线程，画面静止也会用最近一帧重绘
+void RequestPreviewRedraw();
+// 读取器重建或缓冲区被移除后调用，渲染线程在下一帧前释放缓存的 EGLImage
+void InvalidatePreviewImageCache();
 
 #endif // BRIDGE_PREVIEW_H
@@ -0,0 +1,159 @@
+#include "bridge_preview_blit.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// 小端下字节序为 00 00 00 FF，RGBA 窗口也是不透明黑
+static constexpr uint32_t kOpaqueBlack = 0xFF000000u;
+
+// 读取一个 BGR 像素及其后 1 字节；step >= 2 时后一字节仍属于同一行的下一个源像素
+static inline uint32_t LoadBgrPixel(const uint8_t *src) {
+    uint32_t v;
+    memcpy(&v, src, sizeof(v));
+    return v;
+}
+
+void ScaleBgrRowToRgbx(const uint8_t *__restrict src, uint8_t *__restrict dst, int dst_width,
+                       int step) {
+    int x = 0;
+    const int srcAdvance = step * 3;
+
+#if defined(__ARM_NEON)
+    const uint8x16_t alpha = vdupq_n_u8(0xFF);
+    if (step == 1) {
+        for (; x <= dst_width - 16; x += 16) {
+            const uint8x16x3_t bgr = vld3q_u8(src);
+            src += 48;
+            uint8x16x4_t rgbx;
+            rgbx.val[0] = bgr.val[2];
+            rgbx.val[1] = bgr.val[1];
+            rgbx.val[2] = bgr.val[0];
+            rgbx.val[3] = alpha;
+            vst4q_u8(dst, rgbx);
+            dst += 64;
+        }
+    } else if (step == 2) {
+        // 读 32 个源像素，vuzp 取偶数位
+        for (; x <= dst_width - 16; x += 16) {
+            const uint8x16x3_t lo = vld3q_u8(src);
+            const uint8x16x3_t hi = vld3q_u8(src + 48);
+            src += 96;
+            uint8x16x4_t rgbx;
+            rgbx.val[0] = vuzpq_u8(lo.val[2], hi.val[2]).val[0];
+            rgbx.val[1] = vuzpq_u8(lo.val[1], hi.val[1]).val[0];
+            rgbx.val[2] = vuzpq_u8(lo.val[0], hi.val[0]).val[0];
+            rgbx.val[3] = alpha;
+            vst4q_u8(dst, rgbx);
+            dst += 64;
+        }
+    } else if (step >= 3) {
+        // 悬浮窗显示整帧时的常见倍数：每次取 4 个源像素拼成向量，
+        // 字内字节反转为 X R G B 后右移 8 位即得 R G B 0
+        const uint32x4_t opaque = vdupq_n_u32(kOpaqueBlack);
+        for (; x + 4 <= dst_width; x += 4) {
+            uint32x4_t px = vdupq_n_u32(LoadBgrPixel(src));
+            px = vsetq_lane_u32(LoadBgrPixel(src + srcAdvance), px, 1);
+            px = vsetq_lane_u32(LoadBgrPixel(src + srcAdvance * 2), px, 2);
+            px = vsetq_lane_u32(LoadBgrPixel(src + srcAdvance * 3), px, 3);
+            const uint32x4_t rgb =
+                    vshrq_n_u32(vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(px))), 8);
+            vst1q_u8(dst, vreinterpretq_u8_u32(vorrq_u32(rgb, opaque)));
+            src += srcAdvance * 4;
+            dst += 16;
+        }
+    }
+#elif defined(__SSSE3__)
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(kOpaqueBlack));
+    if (step == 1) {
+        // 每次读 16 字节、用 12 字节，留足 6 像素余量避免越过行尾
+        const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+        for (; x + 6 <= dst_width; x += 4) {
+            const __m128i bgr = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                             _mm_or_si128(_mm_shuffle_epi8(bgr, shuffle), alpha));
+            src += 12;
+            dst += 16;
+        }
+    } else if (step == 2) {
+        // 两次读取各取相隔 2 像素的一对，第二次读到源偏移 6x+28，留足 5 个目标像素余量
+        const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 8, 7, 6, -1,
+                                              -1, -1, -1, -1, -1, -1, -1, -1);
+        for (; x + 5 <= dst_width; x += 4) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 12));
+            const __m128i rgb = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, shuffle),
+                                                   _mm_shuffle_epi8(hi, shuffle));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(rgb, alpha));
+            src += 24;
+            dst += 16;
+        }
+    } else if (step >= 3) {
+        // 每次取 4 个源像素拼成向量，与 step 1 共用同一种交换方式
+        const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1,
+                                              10, 9, 8, -1, 14, 13, 12, -1);
+        for (; x + 4 <= dst_width; x += 4) {
+            const __m128i bgr = _mm_setr_epi32(
+                    static_cast<int>(LoadBgrPixel(src)),
+                    static_cast<int>(LoadBgrPixel(src + srcAdvance)),
+                    static_cast<int>(LoadBgrPixel(src + srcAdvance * 2)),
+                    static_cast<int>(LoadBgrPixel(src + srcAdvance * 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                             _mm_or_si128(_mm_shuffle_epi8(bgr, shuffle), alpha));
+            src += srcAdvance * 4;
+            dst += 16;
+        }
+    }
+#endif
+    for (; x < dst_width; ++x) {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        dst[3] = 0xFF;
+        src += srcAdvance;
+        dst += 4;
+    }
+}
+
+bool BlitFrameToWindow(const BlitWindowOps *ops, void *ctx, const uint8_t *bgr, int width,
+                       int height, int src_stride) {
+    if (!ops || !bgr || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    BlitTarget target = {};
+    if (!ops->lock(ctx, &target)) {
+        return false;
+    }
+    if (!target.pixels || target.width <= 0 || target.height <= 0) {
+        ops->post(ctx);
+        return false;
+    }
+
+    // 满足 width / step <= target.width 的最小 step
+    const int step = std::max(width / (target.width + 1), height / (target.height + 1)) + 1;
+    const int outWidth = width / step;
+    const int outHeight = height / step;
+    const int outX = (target.width - outWidth) / 2;
+    const int outY = (target.height - outHeight) / 2;
+
+    for (int y = 0; y < target.height; ++y) {
+        uint32_t *row = target.pixels + static_cast<size_t>(y) * target.stride;
+        if (y < outY || y >= outY + outHeight) {
+            std::fill_n(row, target.width, kOpaqueBlack);
+            continue;
+        }
+        std::fill_n(row, outX, kOpaqueBlack);
+        ScaleBgrRowToRgbx(bgr + static_cast<size_t>(y - outY) * step * src_stride,
+                          reinterpret_cast<uint8_t *>(row + outX), outWidth, step);
+        std::fill_n(row + outX + outWidth, target.width - outX - outWidth, kOpaqueBlack);
+    }
+
+    ops->post(ctx);
+    return true;
+}
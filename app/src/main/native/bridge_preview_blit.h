@@ -0,0 +1,31 @@
+#ifndef BRIDGE_PREVIEW_BLIT_H
+#define BRIDGE_PREVIEW_BLIT_H
+
+#include <cstdint>
+
+// EGL 不可用时的 CPU 预览：把 BGR 帧按整数倍抽样缩小、交换通道后写入窗口缓冲区。
+// 不依赖 Android 头文件，窗口访问经 BlitWindowOps 注入，可用内存缓冲代替
+
+// 目标缓冲区为 RGBX8888，stride 以像素计
+struct BlitTarget {
+    uint32_t *pixels;
+    int width;
+    int height;
+    int stride;
+};
+
+struct BlitWindowOps {
+    // 成功时填写 target，之后必须调用 post
+    bool (*lock)(void *ctx, BlitTarget *target);
+    void (*post)(void *ctx);
+};
+
+// 从 src 起每 step 个像素取一个，写出 dst_width 个 RGBX 像素；src 至少有 dst_width * step 个像素
+void ScaleBgrRowToRgbx(const uint8_t *__restrict src, uint8_t *__restrict dst, int dst_width,
+                       int step);
+
+// 缩小倍数取能放进窗口的最小整数，不放大；画面居中，其余填黑
+bool BlitFrameToWindow(const BlitWindowOps *ops, void *ctx, const uint8_t *bgr, int width,
+                       int height, int src_stride);
+
+#endif // BRIDGE_PREVIEW_BLIT_H
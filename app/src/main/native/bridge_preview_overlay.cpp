@@ -0,0 +1,333 @@
+#include "bridge_preview_overlay.h"
+
+#include "bridge_preview.h"
+
+#include <EGL/egl.h>
+#include <GLES2/gl2.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+// 与 Compose 版触摸预览保持一致的配色和寿命
+static constexpr int64_t kMarkerTtlNs = 600000000LL;
+static constexpr uint32_t kMaxActiveMarkers = 8;
+static constexpr uint32_t kTouchRingSize = 16;
+static constexpr uint32_t kMaxPreviewRois = 16;
+
+// 每个标记最多 3 个点精灵，每个 ROI 4 条线段
+static constexpr int kVertexFloats = 8;
+static constexpr int kMaxOverlayVertices = kMaxActiveMarkers * 3 + kMaxPreviewRois * 8;
+
+// 预览程序固定使用 0、1 号属性，叠加层使用 2~4 号，切换程序时互不覆盖各自的顶点指针
+static constexpr GLuint kOverlayPositionLoc = 2;
+static constexpr GLuint kOverlayColorLoc = 3;
+static constexpr GLuint kOverlayPointLoc = 4;
+
+// 单槽序号锁：写入期间序号为奇数，读取前后序号不一致则丢弃该槽
+struct TouchMarkerSlot {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<int32_t> x{0};
+    std::atomic<int32_t> y{0};
+    std::atomic<int32_t> method{0};
+    std::atomic<int64_t> time_ns{0};
+};
+
+static TouchMarkerSlot g_touchRing[kTouchRingSize];
+static std::atomic<uint32_t> g_touchHead{0};
+static std::atomic<bool> g_touchMarkersEnabled{false};
+
+static std::mutex g_roiMutex;
+static RoiRect g_rois[kMaxPreviewRois];
+static std::atomic<uint32_t> g_roiCount{0};
+
+static GLuint g_overlayProgram = 0;
+static GLuint g_overlayBuffer = 0;
+static GLint g_pointModeLoc = -1;
+static GLfloat g_overlayVertices[kMaxOverlayVertices * kVertexFloats];
+
+static const char *OVERLAY_VERTEX_SHADER = R"(
+attribute vec2 aPosition;
+attribute vec4 aColor;
+attribute vec2 aPoint;
+varying vec4 vColor;
+varying float vRing;
+void main() {
+    gl_Position = vec4(aPosition, 0.0, 1.0);
+    gl_PointSize = aPoint.x;
+    vColor = aColor;
+    vRing = aPoint.y;
+}
+)";
+
+// vRing > 0 为圆环（值为环宽占半径的比例），0 为实心圆，< 0 为径向渐隐；输出预乘 alpha
+static const char *OVERLAY_FRAGMENT_SHADER = R"(
+precision mediump float;
+uniform float uPointMode;
+varying vec4 vColor;
+varying float vRing;
+void main() {
+    float alpha = vColor.a;
+    if (uPointMode > 0.5) {
+        float r = length(gl_PointCoord * 2.0 - 1.0);
+        if (r > 1.0) {
+            discard;
+        }
+        if (vRing > 0.0) {
+            alpha *= step(1.0 - vRing, r);
+        } else if (vRing < 0.0) {
+            alpha *= 1.0 - r;
+        }
+    }
+    gl_FragColor = vec4(vColor.rgb * alpha, alpha);
+}
+)";
+
+void PushPreviewTouch(int x, int y, MethodType method) {
+    if (!g_touchMarkersEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    TouchMarkerSlot &slot = g_touchRing[g_touchHead.fetch_add(1, std::memory_order_acq_rel) %
+                                        kTouchRingSize];
+    const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.x.store(x, std::memory_order_relaxed);
+    slot.y.store(y, std::memory_order_relaxed);
+    slot.method.store(method, std::memory_order_relaxed);
+    slot.time_ns.store(MonotonicNowNs(), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+    RequestPreviewRedraw();
+}
+
+bool IsPreviewOverlayAnimating() {
+    const uint32_t head = g_touchHead.load(std::memory_order_acquire);
+    if (!g_touchMarkersEnabled.load(std::memory_order_relaxed) || head == 0) {
+        return false;
+    }
+    const int64_t time = g_touchRing[(head - 1) % kTouchRingSize].time_ns.load(
+            std::memory_order_relaxed);
+    return MonotonicNowNs() - time < kMarkerTtlNs;
+}
+
+void SetPreviewTouchMarkersEnabled(bool enabled) {
+    g_touchMarkersEnabled.store(enabled, std::memory_order_relaxed);
+    LOGI("SetPreviewTouchMarkersEnabled: %d", enabled);
+}
+
+BRIDGE_API int SetPreviewRois(const RoiRect *rects, uint32_t count) {
+    if (count > 0 && !rects) {
+        return -1;
+    }
+    count = std::min(count, kMaxPreviewRois);
+    std::lock_guard<std::mutex> lock(g_roiMutex);
+    std::copy(rects, rects + count, g_rois);
+    g_roiCount.store(count, std::memory_order_release);
+    RequestPreviewRedraw();
+    return static_cast<int>(count);
+}
+
+static GLuint CompileOverlayShader(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+bool InitPreviewOverlay() {
+    GLuint vShader = CompileOverlayShader(GL_VERTEX_SHADER, OVERLAY_VERTEX_SHADER);
+    GLuint fShader = CompileOverlayShader(GL_FRAGMENT_SHADER, OVERLAY_FRAGMENT_SHADER);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vShader);
+    glAttachShader(program, fShader);
+    glBindAttribLocation(program, kOverlayPositionLoc, "aPosition");
+    glBindAttribLocation(program, kOverlayColorLoc, "aColor");
+    glBindAttribLocation(program, kOverlayPointLoc, "aPoint");
+    glLinkProgram(program);
+    glDeleteShader(vShader);
+    glDeleteShader(fShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        LOGE("InitPreviewOverlay: program link failed");
+        glDeleteProgram(program);
+        return false;
+    }
+    g_overlayProgram = program;
+    g_pointModeLoc = glGetUniformLocation(program, "uPointMode");
+    glGenBuffers(1, &g_overlayBuffer);
+    return true;
+}
+
+void ReleasePreviewOverlay(bool context_current) {
+    if (context_current) {
+        if (g_overlayBuffer) {
+            glDeleteBuffers(1, &g_overlayBuffer);
+        }
+        if (g_overlayProgram) {
+            glDeleteProgram(g_overlayProgram);
+        }
+    }
+    g_overlayBuffer = 0;
+    g_overlayProgram = 0;
+    g_pointModeLoc = -1;
+}
+
+static GLfloat *PutVertex(GLfloat *v, float x, float y, uint32_t rgb, float alpha, float size,
+                          float ring) {
+    v[0] = x;
+    v[1] = y;
+    v[2] = static_cast<float>((rgb >> 16) & 0xff) / 255.0f;
+    v[3] = static_cast<float>((rgb >> 8) & 0xff) / 255.0f;
+    v[4] = static_cast<float>(rgb & 0xff) / 255.0f;
+    v[5] = alpha;
+    v[6] = size;
+    v[7] = ring;
+    return v + kVertexFloats;
+}
+
+// 圆环宽度换算为占半径的比例
+static float RingFraction(float width, float radius) {
+    return radius > 0.0f ? std::min(1.0f, std::max(width, 1.0f) / radius) : 1.0f;
+}
+
+static GLfloat *PutMarker(GLfloat *v, float cx, float cy, int method, float progress, float unit) {
+    constexpr uint32_t kGreen = 0x81C784;
+    constexpr uint32_t kAmber = 0xFFD54F;
+    constexpr uint32_t kRed = 0xE57373;
+    constexpr uint32_t kWhite = 0xFFFFFF;
+    const float alpha = 1.0f - progress;
+    switch (method) {
+        case TOUCH_DOWN: {
+            const float radius = (8.0f + 12.0f * progress) * unit;
+            v = PutVertex(v, cx, cy, kGreen, alpha * 0.3f, radius * 2.0f,
+                          RingFraction(1.5f * unit * alpha, radius));
+            v = PutVertex(v, cx, cy, kGreen, alpha * 0.8f, 24.0f * unit, -1.0f);
+            v = PutVertex(v, cx, cy, kWhite, alpha * 0.9f, 5.0f * unit, 0.0f);
+            break;
+        }
+        case TOUCH_MOVE:
+            v = PutVertex(v, cx, cy, kAmber, alpha * 0.5f, 10.0f * unit, 0.0f);
+            v = PutVertex(v, cx, cy, kWhite, alpha * 0.4f, 3.0f * unit, 0.0f);
+            break;
+        case TOUCH_UP: {
+            const float radius = (6.0f + 18.0f * progress) * unit;
+            v = PutVertex(v, cx, cy, kRed, alpha * 0.6f, radius * 2.0f,
+                          RingFraction(2.0f * unit * alpha, radius));
+            v = PutVertex(v, cx, cy, kRed, alpha * 0.8f, 6.0f * unit * alpha, 0.0f);
+            break;
+        }
+        default:
+            break;
+    }
+    return v;
+}
+
+bool DrawPreviewOverlay(int frame_width, int frame_height) {
+    if (!g_overlayProgram || frame_width <= 0 || frame_height <= 0) {
+        return false;
+    }
+    const uint32_t head = g_touchHead.load(std::memory_order_acquire);
+    const bool markers = g_touchMarkersEnabled.load(std::memory_order_relaxed) && head > 0;
+    const uint32_t roiCount = g_roiCount.load(std::memory_order_acquire);
+    if (!markers && roiCount == 0) {
+        return false;
+    }
+
+    // 帧像素坐标换算到裁剪坐标，帧第 0 行在上
+    const float sx = 2.0f / static_cast<float>(frame_width);
+    const float sy = 2.0f / static_cast<float>(frame_height);
+    GLfloat *v = g_overlayVertices;
+
+    {
+        std::lock_guard<std::mutex> lock(g_roiMutex);
+        const uint32_t count = std::min(g_roiCount.load(std::memory_order_relaxed), kMaxPreviewRois);
+        for (uint32_t i = 0; i < count; ++i) {
+            const RoiRect &r = g_rois[i];
+            const float x0 = r.x * sx - 1.0f;
+            const float x1 = (r.x + r.width) * sx - 1.0f;
+            const float y0 = 1.0f - r.y * sy;
+            const float y1 = 1.0f - (r.y + r.height) * sy;
+            const float corners[5][2] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}, {x0, y0}};
+            for (int e = 0; e < 4; ++e) {
+                v = PutVertex(v, corners[e][0], corners[e][1], 0x4FC3F7, 0.9f, 1.0f, 0.0f);
+                v = PutVertex(v, corners[e + 1][0], corners[e + 1][1], 0x4FC3F7, 0.9f, 1.0f, 0.0f);
+            }
+        }
+    }
+    const GLsizei lineVertices = static_cast<GLsizei>((v - g_overlayVertices) / kVertexFloats);
+
+    if (markers) {
+        // 标记尺寸按预览表面大小缩放，约等于 Compose 版中的 1dp
+        EGLint surfaceWidth = 0;
+        EGLint surfaceHeight = 0;
+        EGLDisplay display = eglGetCurrentDisplay();
+        EGLSurface surface = eglGetCurrentSurface(EGL_DRAW);
+        eglQuerySurface(display, surface, EGL_WIDTH, &surfaceWidth);
+        eglQuerySurface(display, surface, EGL_HEIGHT, &surfaceHeight);
+        const float unit = std::max(1.0f, std::min(surfaceWidth, surfaceHeight) / 240.0f);
+
+        const int64_t now = MonotonicNowNs();
+        const uint32_t scan = std::min(head, kTouchRingSize);
+        uint32_t drawn = 0;
+        for (uint32_t i = 0; i < scan && drawn < kMaxActiveMarkers; ++i) {
+            TouchMarkerSlot &slot = g_touchRing[(head - 1 - i) % kTouchRingSize];
+            const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq & 1) {
+                continue;
+            }
+            const int x = slot.x.load(std::memory_order_relaxed);
+            const int y = slot.y.load(std::memory_order_relaxed);
+            const int method = slot.method.load(std::memory_order_relaxed);
+            const int64_t time = slot.time_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                continue;
+            }
+            const int64_t age = now - time;
+            if (age < 0 || age >= kMarkerTtlNs) {
+                continue;
+            }
+            const float progress = static_cast<float>(age) / static_cast<float>(kMarkerTtlNs);
+            v = PutMarker(v, x * sx - 1.0f, 1.0f - y * sy, method, progress, unit);
+            ++drawn;
+        }
+    }
+    const GLsizei totalVertices = static_cast<GLsizei>((v - g_overlayVertices) / kVertexFloats);
+    if (totalVertices == 0) {
+        return false;
+    }
+
+    glUseProgram(g_overlayProgram);
+    glBindBuffer(GL_ARRAY_BUFFER, g_overlayBuffer);
+    glBufferData(GL_ARRAY_BUFFER, totalVertices * kVertexFloats * sizeof(GLfloat),
+                 g_overlayVertices, GL_STREAM_DRAW);
+    const GLsizei stride = kVertexFloats * sizeof(GLfloat);
+    glEnableVertexAttribArray(kOverlayPositionLoc);
+    glVertexAttribPointer(kOverlayPositionLoc, 2, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void *>(0));
+    glEnableVertexAttribArray(kOverlayColorLoc);
+    glVertexAttribPointer(kOverlayColorLoc, 4, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void *>(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(kOverlayPointLoc);
+    glVertexAttribPointer(kOverlayPointLoc, 2, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void *>(6 * sizeof(GLfloat)));
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (lineVertices > 0) {
+        glUniform1f(g_pointModeLoc, 0.0f);
+        glDrawArrays(GL_LINES, 0, lineVertices);
+    }
+    if (totalVertices > lineVertices) {
+        glUniform1f(g_pointModeLoc, 1.0f);
+        glDrawArrays(GL_POINTS, lineVertices, totalVertices - lineVertices);
+    }
+
+    glDisable(GL_BLEND);
+    glDisableVertexAttribArray(kOverlayPositionLoc);
+    glDisableVertexAttribArray(kOverlayColorLoc);
+    glDisableVertexAttribArray(kOverlayPointLoc);
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef BRIDGE_PREVIEW_OVERLAY_H
+#define BRIDGE_PREVIEW_OVERLAY_H
+
+#include "bridge_internal.h"
+
+// 触摸标记在注入输入时写入，渲染线程在预览画面之后同一趟绘制中叠加；坐标为帧像素坐标
+void PushPreviewTouch(int x, int y, MethodType method);
+void SetPreviewTouchMarkersEnabled(bool enabled);
+// 仍有未淡出的标记
+bool IsPreviewOverlayAnimating();
+
+// 以下需在渲染线程、上下文为当前时调用
+bool InitPreviewOverlay();
+// context_current 为 false 时上下文已不可用，只清空句柄
+void ReleasePreviewOverlay(bool context_current);
+// 会切换当前程序，调用方每帧绘制前自行选择程序；返回是否画了内容
+bool DrawPreviewOverlay(int frame_width, int frame_height);
+
+#endif // BRIDGE_PREVIEW_OVERLAY_H
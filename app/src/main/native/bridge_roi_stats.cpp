@@ -0,0 +1,231 @@
+#include "bridge_roi_stats.h"
+
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// 积分图按 4x4 像素的格子统计，查询矩形向外对齐到格子边界
+#define ROI_STATS_CELL_SHIFT 2
+#define ROI_STATS_CELL (1 << ROI_STATS_CELL_SHIFT)
+#define ROI_GRAY_SPREAD 24
+#define ROI_DOMINANT_MARGIN 48
+
+struct RoiStatsEntry {
+    uint32_t sum_b;
+    uint32_t sum_g;
+    uint32_t sum_r;
+    uint32_t sum_y;
+    uint64_t sum_y2;
+    uint32_t luma_hist[ROI_STATS_LUMA_BINS];
+    uint32_t gray;
+    uint32_t red;
+    uint32_t green;
+    uint32_t blue;
+};
+
+struct RoiStatsTable {
+    int64_t frame_count = 0;
+    int cells_w = 0;
+    int cells_h = 0;
+    std::vector<RoiStatsEntry> sat;
+};
+
+static RoiStatsTable g_tables[FRAME_BUFFER_COUNT];
+static std::vector<RoiStatsEntry> g_cellRow;
+static std::atomic<bool> g_roiStatsEnabled{false};
+
+static inline void AddEntry(RoiStatsEntry *dst, const RoiStatsEntry &src) {
+    dst->sum_b += src.sum_b;
+    dst->sum_g += src.sum_g;
+    dst->sum_r += src.sum_r;
+    dst->sum_y += src.sum_y;
+    dst->sum_y2 += src.sum_y2;
+    for (int i = 0; i < ROI_STATS_LUMA_BINS; ++i) {
+        dst->luma_hist[i] += src.luma_hist[i];
+    }
+    dst->gray += src.gray;
+    dst->red += src.red;
+    dst->green += src.green;
+    dst->blue += src.blue;
+}
+
+static inline void AccumulatePixel(RoiStatsEntry *cell, const uint8_t *px) {
+    const int b = px[0];
+    const int g = px[1];
+    const int r = px[2];
+    const uint32_t y = BgrToLuma(px);
+    cell->sum_b += b;
+    cell->sum_g += g;
+    cell->sum_r += r;
+    cell->sum_y += y;
+    cell->sum_y2 += y * y;
+    cell->luma_hist[y * ROI_STATS_LUMA_BINS >> 8] += 1;
+
+    const int hi = std::max(b, std::max(g, r));
+    const int lo = std::min(b, std::min(g, r));
+    if (hi - lo < ROI_GRAY_SPREAD) {
+        cell->gray += 1;
+    } else if (r - std::max(g, b) >= ROI_DOMINANT_MARGIN) {
+        cell->red += 1;
+    } else if (g - std::max(r, b) >= ROI_DOMINANT_MARGIN) {
+        cell->green += 1;
+    } else if (b - std::max(r, g) >= ROI_DOMINANT_MARGIN) {
+        cell->blue += 1;
+    }
+}
+
+static bool BeginRoiStats(const FrameBuffer *frame) {
+    RoiStatsTable &table = g_tables[frame->index];
+    table.frame_count = 0;
+    if (!g_roiStatsEnabled.load(std::memory_order_acquire)) {
+        // 关闭后逐个回收正在写入的槽位，不会碰到读者持有的槽位
+        std::vector<RoiStatsEntry>().swap(table.sat);
+        return false;
+    }
+
+    table.cells_w = (frame->width + ROI_STATS_CELL - 1) >> ROI_STATS_CELL_SHIFT;
+    table.cells_h = (frame->height + ROI_STATS_CELL - 1) >> ROI_STATS_CELL_SHIFT;
+    table.sat.assign(static_cast<size_t>(table.cells_w + 1) * (table.cells_h + 1),
+                     RoiStatsEntry{});
+    g_cellRow.assign(static_cast<size_t>(table.cells_w), RoiStatsEntry{});
+    return true;
+}
+
+static void AccumulateRoiStatsRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    RoiStatsTable &table = g_tables[frame->index];
+    RoiStatsEntry *cells = g_cellRow.data();
+    for (int x = 0; x < frame->width; ++x) {
+        AccumulatePixel(&cells[x >> ROI_STATS_CELL_SHIFT], bgr + x * 3);
+    }
+
+    if ((y & (ROI_STATS_CELL - 1)) != ROI_STATS_CELL - 1 && y != frame->height - 1) {
+        return;
+    }
+
+    // 一行格子累计完毕，写入积分图：sat[cy + 1][cx + 1] = sat[cy][cx + 1] + 本行前缀和
+    const size_t pitch = static_cast<size_t>(table.cells_w) + 1;
+    const int cy = y >> ROI_STATS_CELL_SHIFT;
+    const RoiStatsEntry *above = table.sat.data() + cy * pitch;
+    RoiStatsEntry *out = table.sat.data() + (cy + 1) * pitch;
+    RoiStatsEntry prefix{};
+    for (int cx = 0; cx < table.cells_w; ++cx) {
+        AddEntry(&prefix, cells[cx]);
+        out[cx + 1] = above[cx + 1];
+        AddEntry(&out[cx + 1], prefix);
+        cells[cx] = RoiStatsEntry{};
+    }
+}
+
+static void CommitRoiStats(const FrameBuffer *frame) {
+    g_tables[frame->index].frame_count = frame->frame_count;
+}
+
+static void ReleaseRoiStats() {
+    for (RoiStatsTable &table : g_tables) {
+        table.frame_count = 0;
+        table.cells_w = 0;
+        table.cells_h = 0;
+        std::vector<RoiStatsEntry>().swap(table.sat);
+    }
+    std::vector<RoiStatsEntry>().swap(g_cellRow);
+}
+
+const FrameAnalyzer kRoiStatsAnalyzer = {
+        BeginRoiStats,
+        AccumulateRoiStatsRow,
+        CommitRoiStats,
+        ReleaseRoiStats,
+};
+
+static void RectSum(const RoiStatsTable &table, int cx0, int cy0, int cx1, int cy1,
+                    RoiStatsEntry *sum) {
+    const size_t pitch = static_cast<size_t>(table.cells_w) + 1;
+    const RoiStatsEntry &a = table.sat[cy0 * pitch + cx0];
+    const RoiStatsEntry &b = table.sat[cy0 * pitch + cx1];
+    const RoiStatsEntry &c = table.sat[cy1 * pitch + cx0];
+    const RoiStatsEntry &d = table.sat[cy1 * pitch + cx1];
+
+    // 无符号回绕下 d - b - c + a 仍然正确
+    sum->sum_b = d.sum_b - b.sum_b - c.sum_b + a.sum_b;
+    sum->sum_g = d.sum_g - b.sum_g - c.sum_g + a.sum_g;
+    sum->sum_r = d.sum_r - b.sum_r - c.sum_r + a.sum_r;
+    sum->sum_y = d.sum_y - b.sum_y - c.sum_y + a.sum_y;
+    sum->sum_y2 = d.sum_y2 - b.sum_y2 - c.sum_y2 + a.sum_y2;
+    for (int i = 0; i < ROI_STATS_LUMA_BINS; ++i) {
+        sum->luma_hist[i] = d.luma_hist[i] - b.luma_hist[i] - c.luma_hist[i] + a.luma_hist[i];
+    }
+    sum->gray = d.gray - b.gray - c.gray + a.gray;
+    sum->red = d.red - b.red - c.red + a.red;
+    sum->green = d.green - b.green - c.green + a.green;
+    sum->blue = d.blue - b.blue - c.blue + a.blue;
+}
+
+BRIDGE_API int SetRoiStatsEnabled(int enabled) {
+    g_roiStatsEnabled.store(enabled != 0, std::memory_order_release);
+    return 0;
+}
+
+BRIDGE_API int QueryRoiStats(const RoiRect *rects, uint32_t count, RoiStats *out) {
+    if (!rects || !out) {
+        return -1;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return -1;
+    }
+
+    const RoiStatsTable &table = g_tables[frame->index];
+    if (table.frame_count != frame->frame_count || table.sat.empty()) {
+        UnlockFrame(frame);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const RoiRect &rect = rects[i];
+        RoiStats &stats = out[i];
+        stats = RoiStats{};
+
+        const int x0 = std::max(rect.x, 0);
+        const int y0 = std::max(rect.y, 0);
+        const int x1 = std::min(rect.x + rect.width, frame->width);
+        const int y1 = std::min(rect.y + rect.height, frame->height);
+        if (x1 <= x0 || y1 <= y0) {
+            continue;
+        }
+
+        const int cx0 = x0 >> ROI_STATS_CELL_SHIFT;
+        const int cy0 = y0 >> ROI_STATS_CELL_SHIFT;
+        const int cx1 = (x1 + ROI_STATS_CELL - 1) >> ROI_STATS_CELL_SHIFT;
+        const int cy1 = (y1 + ROI_STATS_CELL - 1) >> ROI_STATS_CELL_SHIFT;
+        RoiStatsEntry sum{};
+        RectSum(table, cx0, cy0, cx1, cy1, &sum);
+
+        const uint32_t pixels =
+                static_cast<uint32_t>(std::min(cx1 << ROI_STATS_CELL_SHIFT, frame->width) -
+                                      (cx0 << ROI_STATS_CELL_SHIFT)) *
+                static_cast<uint32_t>(std::min(cy1 << ROI_STATS_CELL_SHIFT, frame->height) -
+                                      (cy0 << ROI_STATS_CELL_SHIFT));
+        const float inv = 1.0f / static_cast<float>(pixels);
+        stats.pixel_count = pixels;
+        stats.mean_b = static_cast<float>(sum.sum_b) * inv;
+        stats.mean_g = static_cast<float>(sum.sum_g) * inv;
+        stats.mean_r = static_cast<float>(sum.sum_r) * inv;
+        stats.mean_luma = static_cast<float>(sum.sum_y) * inv;
+        stats.var_luma = static_cast<float>(static_cast<double>(sum.sum_y2) * inv -
+                                            static_cast<double>(stats.mean_luma) *
+                                            stats.mean_luma);
+        for (int b = 0; b < ROI_STATS_LUMA_BINS; ++b) {
+            stats.luma_hist[b] = sum.luma_hist[b];
+        }
+        stats.gray_count = sum.gray;
+        stats.red_count = sum.red;
+        stats.green_count = sum.green;
+        stats.blue_count = sum.blue;
+    }
+
+    UnlockFrame(frame);
+    return static_cast<int>(count);
+}
@@ -0,0 +1,8 @@
+#ifndef BRIDGE_ROI_STATS_H
+#define BRIDGE_ROI_STATS_H
+
+#include "bridge_frame_buffer.h"
+
+extern const FrameAnalyzer kRoiStatsAnalyzer;
+
+#endif // BRIDGE_ROI_STATS_H
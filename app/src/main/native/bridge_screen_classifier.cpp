@@ -0,0 +1,271 @@
+#include "bridge_screen_classifier.h"
+
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// dHash：区域缩成 9x8 亮度网格，每行相邻两格比较得到 64 位
+#define DHASH_GRID_WIDTH 9
+#define DHASH_GRID_HEIGHT 8
+#define DHASH_SAMPLE_STEP 2
+
+struct ScreenHashEntry {
+    int screen_id;
+    uint64_t hash;
+    int roi_index;
+};
+
+struct ScreenHashIndex {
+    std::vector<RoiRect> rois;
+    std::vector<ScreenHashEntry> entries;
+};
+
+static std::mutex g_indexMutex;
+static ScreenHashIndex g_index;
+static uint64_t g_indexVersion = 0;
+
+// 以下仅在采集线程访问
+static ScreenHashIndex g_activeIndex;
+static uint64_t g_activeVersion = UINT64_MAX;
+static std::vector<LumaGrid> g_roiGrids;
+static std::vector<bool> g_roiValid;
+
+// 转换时得到的结果及所用索引版本；帧被读者锁定时采集线程不会改写对应槽位
+static ScreenClassification g_results[FRAME_BUFFER_COUNT];
+static uint64_t g_resultVersions[FRAME_BUFFER_COUNT];
+// 读者对锁定帧按需重算的结果，受 g_indexMutex 保护，静止画面上重复查询时复用
+static ScreenClassification g_demandResults[FRAME_BUFFER_COUNT];
+static uint64_t g_demandVersions[FRAME_BUFFER_COUNT];
+
+static uint64_t DHashFromGrid(const LumaGrid *grid) {
+    uint8_t cells[DHASH_GRID_WIDTH * DHASH_GRID_HEIGHT];
+    LumaGridResolve(grid, cells);
+    uint64_t hash = 0;
+    for (int y = 0; y < DHASH_GRID_HEIGHT; ++y) {
+        const uint8_t *row = cells + y * DHASH_GRID_WIDTH;
+        for (int x = 0; x < DHASH_GRID_WIDTH - 1; ++x) {
+            hash = (hash << 1) | (row[x] > row[x + 1] ? 1u : 0u);
+        }
+    }
+    return hash;
+}
+
+static bool ClipRoi(const RoiRect &roi, int width, int height, RoiRect *out) {
+    const int x0 = std::max(roi.x, 0);
+    const int y0 = std::max(roi.y, 0);
+    const int x1 = static_cast<int>(
+            std::min<int64_t>(static_cast<int64_t>(roi.x) + roi.width, width));
+    const int y1 = static_cast<int>(
+            std::min<int64_t>(static_cast<int64_t>(roi.y) + roi.height, height));
+    if (x1 - x0 < DHASH_GRID_WIDTH || y1 - y0 < DHASH_GRID_HEIGHT) {
+        return false;
+    }
+    *out = RoiRect{x0, y0, x1 - x0, y1 - y0};
+    return true;
+}
+
+static bool BeginScreenClassify(const FrameBuffer *frame) {
+    {
+        std::lock_guard<std::mutex> lock(g_indexMutex);
+        if (g_activeVersion != g_indexVersion) {
+            g_activeIndex = g_index;
+            g_activeVersion = g_indexVersion;
+        }
+    }
+
+    g_results[frame->index] = ScreenClassification{-1, -1, frame->frame_count};
+    g_resultVersions[frame->index] = g_activeVersion;
+    if (g_activeIndex.entries.empty()) {
+        return false;
+    }
+
+    g_roiGrids.resize(g_activeIndex.rois.size());
+    g_roiValid.assign(g_activeIndex.rois.size(), false);
+    for (size_t i = 0; i < g_activeIndex.rois.size(); ++i) {
+        RoiRect clipped;
+        if (ClipRoi(g_activeIndex.rois[i], frame->width, frame->height, &clipped)) {
+            LumaGridReset(&g_roiGrids[i], clipped.x, clipped.y, clipped.width, clipped.height,
+                          DHASH_GRID_WIDTH, DHASH_GRID_HEIGHT, DHASH_SAMPLE_STEP);
+            g_roiValid[i] = true;
+        }
+    }
+    return true;
+}
+
+static void AccumulateScreenClassifyRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    (void) frame;
+    for (size_t i = 0; i < g_roiGrids.size(); ++i) {
+        if (g_roiValid[i]) {
+            LumaGridAddRow(&g_roiGrids[i], y, bgr);
+        }
+    }
+}
+
+static ScreenClassification FindBestScreen(const ScreenHashIndex &index,
+                                           const std::vector<uint64_t> &hashes,
+                                           const std::vector<bool> &valid, int64_t frame_count) {
+    ScreenClassification best{-1, -1, frame_count};
+    for (const ScreenHashEntry &entry : index.entries) {
+        if (!valid[entry.roi_index]) {
+            continue;
+        }
+        const int distance = __builtin_popcountll(hashes[entry.roi_index] ^ entry.hash);
+        if (best.distance < 0 || distance < best.distance) {
+            best.screen_id = entry.screen_id;
+            best.distance = distance;
+        }
+    }
+    return best;
+}
+
+static void CommitScreenClassify(const FrameBuffer *frame) {
+    std::vector<uint64_t> hashes(g_roiGrids.size(), 0);
+    for (size_t i = 0; i < g_roiGrids.size(); ++i) {
+        if (g_roiValid[i]) {
+            hashes[i] = DHashFromGrid(&g_roiGrids[i]);
+        }
+    }
+    g_results[frame->index] = FindBestScreen(g_activeIndex, hashes, g_roiValid, frame->frame_count);
+}
+
+static void ReleaseScreenClassify() {
+    for (int i = 0; i < FRAME_BUFFER_COUNT; ++i) {
+        g_results[i] = ScreenClassification{-1, -1, 0};
+        g_resultVersions[i] = UINT64_MAX;
+    }
+    std::lock_guard<std::mutex> lock(g_indexMutex);
+    for (int i = 0; i < FRAME_BUFFER_COUNT; ++i) {
+        g_demandResults[i] = ScreenClassification{-1, -1, 0};
+        g_demandVersions[i] = UINT64_MAX;
+    }
+}
+
+const FrameAnalyzer kScreenClassifierAnalyzer = {
+        BeginScreenClassify,
+        AccumulateScreenClassifyRow,
+        CommitScreenClassify,
+        ReleaseScreenClassify,
+};
+
+static uint64_t HashFrameRoi(const FrameBuffer *frame, const RoiRect &clipped) {
+    LumaGrid grid;
+    LumaGridReset(&grid, clipped.x, clipped.y, clipped.width, clipped.height,
+                  DHASH_GRID_WIDTH, DHASH_GRID_HEIGHT, DHASH_SAMPLE_STEP);
+    for (int y = clipped.y; y < clipped.y + clipped.height; ++y) {
+        LumaGridAddRow(&grid, y, frame->bgr_data + static_cast<size_t>(y) * frame->width * 3);
+    }
+    return DHashFromGrid(&grid);
+}
+
+void ClassifyLockedFrame(const FrameBuffer *frame, ScreenClassification *out) {
+    const int slot = frame->index;
+    ScreenHashIndex index;
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(g_indexMutex);
+        if (g_resultVersions[slot] == g_indexVersion &&
+            g_results[slot].frame_count == frame->frame_count) {
+            *out = g_results[slot];
+            return;
+        }
+        if (g_demandVersions[slot] == g_indexVersion &&
+            g_demandResults[slot].frame_count == frame->frame_count) {
+            *out = g_demandResults[slot];
+            return;
+        }
+        index = g_index;
+        version = g_indexVersion;
+    }
+
+    // 画面静止时没有新帧触发转换，索引变化后直接对锁定的帧重新计算
+    std::vector<uint64_t> hashes(index.rois.size(), 0);
+    std::vector<bool> valid(index.rois.size(), false);
+    if (frame->bgr_data) {
+        for (size_t i = 0; i < index.rois.size(); ++i) {
+            RoiRect clipped;
+            if (ClipRoi(index.rois[i], frame->width, frame->height, &clipped)) {
+                hashes[i] = HashFrameRoi(frame, clipped);
+                valid[i] = true;
+            }
+        }
+    }
+    *out = FindBestScreen(index, hashes, valid, frame->frame_count);
+
+    std::lock_guard<std::mutex> lock(g_indexMutex);
+    g_demandResults[slot] = *out;
+    g_demandVersions[slot] = version;
+}
+
+BRIDGE_API int ComputeScreenHash(const RoiRect *roi, uint64_t *hash) {
+    if (!roi || !hash) {
+        return -1;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return -1;
+    }
+
+    RoiRect clipped;
+    if (!frame->bgr_data || !ClipRoi(*roi, frame->width, frame->height, &clipped)) {
+        UnlockFrame(frame);
+        return -1;
+    }
+
+    *hash = HashFrameRoi(frame, clipped);
+    UnlockFrame(frame);
+    return 0;
+}
+
+BRIDGE_API int RegisterScreenHash(int screen_id, const RoiRect *roi, uint64_t hash) {
+    if (!roi || roi->width < DHASH_GRID_WIDTH || roi->height < DHASH_GRID_HEIGHT) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(g_indexMutex);
+    int roiIndex = -1;
+    for (size_t i = 0; i < g_index.rois.size(); ++i) {
+        const RoiRect &r = g_index.rois[i];
+        if (r.x == roi->x && r.y == roi->y && r.width == roi->width && r.height == roi->height) {
+            roiIndex = static_cast<int>(i);
+            break;
+        }
+    }
+    if (roiIndex < 0) {
+        roiIndex = static_cast<int>(g_index.rois.size());
+        g_index.rois.push_back(*roi);
+    }
+    g_index.entries.push_back(ScreenHashEntry{screen_id, hash, roiIndex});
+    ++g_indexVersion;
+    return 0;
+}
+
+BRIDGE_API int ClearScreenHashes(void) {
+    std::lock_guard<std::mutex> lock(g_indexMutex);
+    g_index.rois.clear();
+    g_index.entries.clear();
+    ++g_indexVersion;
+    return 0;
+}
+
+BRIDGE_API int GetScreenClassification(ScreenClassification *out) {
+    if (!out) {
+        return -1;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return -1;
+    }
+
+    ScreenClassification result;
+    ClassifyLockedFrame(frame, &result);
+    UnlockFrame(frame);
+    if (result.screen_id < 0) {
+        return -1;
+    }
+    *out = result;
+    return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef BRIDGE_SCREEN_CLASSIFIER_H
+#define BRIDGE_SCREEN_CLASSIFIER_H
+
+#include "bridge_frame_buffer.h"
+
+extern const FrameAnalyzer kScreenClassifierAnalyzer;
+
+// frame 须为默认帧池中已锁定的帧；转换后索引有变化时按当前索引对该帧重新计算
+void ClassifyLockedFrame(const FrameBuffer *frame, ScreenClassification *out);
+
+#endif // BRIDGE_SCREEN_CLASSIFIER_H
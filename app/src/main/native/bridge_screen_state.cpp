@@ -0,0 +1,182 @@
+#include "bridge_screen_state.h"
+
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#define SCREEN_THUMB_HISTORY 32
+#define SCREEN_THUMB_SAMPLE_STEP 4
+#define SCREEN_THUMB_PIXELS (SCREEN_THUMB_WIDTH * SCREEN_THUMB_HEIGHT)
+#define SCREEN_STABLE_TRACKERS 4
+
+struct ScreenThumb {
+    uint8_t luma[SCREEN_THUMB_PIXELS];
+    int64_t time_ns;
+    int64_t frame_count;
+};
+
+// 环形历史只覆盖约 32 帧，持续出帧时回溯不到 1 秒；按查询用过的阈值各保留一个参考缩略图，
+// 新缩略图与参考相差超过阈值时才重置起始时间，稳定时长不受历史长度限制
+struct StableTracker {
+    int threshold;
+    uint8_t reference[SCREEN_THUMB_PIXELS];
+    int64_t since_ns;
+    int64_t last_query_ns;
+};
+
+static LumaGrid g_thumbGrid;
+static ScreenThumb g_thumbs[SCREEN_THUMB_HISTORY];
+static int g_thumbHead = 0;
+static int g_thumbSize = 0;
+static std::mutex g_thumbMutex;
+static std::condition_variable g_thumbCv;
+static StableTracker g_stableTrackers[SCREEN_STABLE_TRACKERS];
+static int g_stableTrackerCount = 0;
+
+static int ThumbMeanAbsDiff(const uint8_t *a, const uint8_t *b) {
+    uint32_t sum = 0;
+    for (int i = 0; i < SCREEN_THUMB_PIXELS; ++i) {
+        sum += static_cast<uint32_t>(std::abs(a[i] - b[i]));
+    }
+    return static_cast<int>(sum / SCREEN_THUMB_PIXELS);
+}
+
+// 从最新缩略图往回找，返回与之相差不超过 threshold 的连续区间的起始时间；无缩略图返回 -1
+static int64_t HistoryStableSinceLocked(int threshold) {
+    if (g_thumbSize == 0) {
+        return -1;
+    }
+
+    const int newest = (g_thumbHead + SCREEN_THUMB_HISTORY - 1) % SCREEN_THUMB_HISTORY;
+    int64_t since = g_thumbs[newest].time_ns;
+    for (int i = 1; i < g_thumbSize; ++i) {
+        const ScreenThumb &older = g_thumbs[(newest + SCREEN_THUMB_HISTORY - i) % SCREEN_THUMB_HISTORY];
+        if (ThumbMeanAbsDiff(g_thumbs[newest].luma, older.luma) > threshold) {
+            break;
+        }
+        since = older.time_ns;
+    }
+    return since;
+}
+
+// 首次以某个阈值查询时从环形历史初始化，跟踪器满时替换最久未查询的一个
+static int64_t StableSinceLocked(int threshold) {
+    const int64_t now = MonotonicNowNs();
+    for (int i = 0; i < g_stableTrackerCount; ++i) {
+        StableTracker &tracker = g_stableTrackers[i];
+        if (tracker.threshold == threshold) {
+            tracker.last_query_ns = now;
+            return tracker.since_ns;
+        }
+    }
+
+    const int64_t since = HistoryStableSinceLocked(threshold);
+    if (since < 0) {
+        return -1;
+    }
+    StableTracker *tracker = &g_stableTrackers[0];
+    if (g_stableTrackerCount < SCREEN_STABLE_TRACKERS) {
+        tracker = &g_stableTrackers[g_stableTrackerCount++];
+    } else {
+        for (StableTracker &entry : g_stableTrackers) {
+            if (entry.last_query_ns < tracker->last_query_ns) {
+                tracker = &entry;
+            }
+        }
+    }
+    const int newest = (g_thumbHead + SCREEN_THUMB_HISTORY - 1) % SCREEN_THUMB_HISTORY;
+    tracker->threshold = threshold;
+    memcpy(tracker->reference, g_thumbs[newest].luma, SCREEN_THUMB_PIXELS);
+    tracker->since_ns = since;
+    tracker->last_query_ns = now;
+    return since;
+}
+
+static bool BeginScreenThumb(const FrameBuffer *frame) {
+    LumaGridReset(&g_thumbGrid, 0, 0, frame->width, frame->height,
+                  SCREEN_THUMB_WIDTH, SCREEN_THUMB_HEIGHT, SCREEN_THUMB_SAMPLE_STEP);
+    return true;
+}
+
+static void AccumulateScreenThumbRow(const FrameBuffer *frame, int y, const uint8_t *bgr) {
+    (void) frame;
+    LumaGridAddRow(&g_thumbGrid, y, bgr);
+}
+
+static void CommitScreenThumb(const FrameBuffer *frame) {
+    {
+        std::lock_guard<std::mutex> lock(g_thumbMutex);
+        ScreenThumb &thumb = g_thumbs[g_thumbHead];
+        LumaGridResolve(&g_thumbGrid, thumb.luma);
+        thumb.time_ns = MonotonicNowNs();
+        thumb.frame_count = frame->frame_count;
+        for (int i = 0; i < g_stableTrackerCount; ++i) {
+            StableTracker &tracker = g_stableTrackers[i];
+            if (ThumbMeanAbsDiff(thumb.luma, tracker.reference) > tracker.threshold) {
+                memcpy(tracker.reference, thumb.luma, SCREEN_THUMB_PIXELS);
+                tracker.since_ns = thumb.time_ns;
+            }
+        }
+        g_thumbHead = (g_thumbHead + 1) % SCREEN_THUMB_HISTORY;
+        if (g_thumbSize < SCREEN_THUMB_HISTORY) {
+            ++g_thumbSize;
+        }
+    }
+    g_thumbCv.notify_all();
+}
+
+static void ResetScreenThumbs() {
+    {
+        std::lock_guard<std::mutex> lock(g_thumbMutex);
+        g_thumbHead = 0;
+        g_thumbSize = 0;
+        g_stableTrackerCount = 0;
+    }
+    g_thumbCv.notify_all();
+}
+
+const FrameAnalyzer kScreenStateAnalyzer = {
+        BeginScreenThumb,
+        AccumulateScreenThumbRow,
+        CommitScreenThumb,
+        ResetScreenThumbs,
+};
+
+BRIDGE_API int IsScreenStable(uint32_t min_duration_ms, int threshold) {
+    std::lock_guard<std::mutex> lock(g_thumbMutex);
+    const int64_t since = StableSinceLocked(threshold);
+    if (since < 0) {
+        return -1;
+    }
+    // 虚拟屏画面不变时不会产生新帧，所以稳定时长按当前时间计算，而不是最后一帧的时间
+    return MonotonicNowNs() - since >= static_cast<int64_t>(min_duration_ms) * 1000000 ? 1 : 0;
+}
+
+BRIDGE_API int WaitForStableScreen(uint32_t min_duration_ms, int threshold, uint32_t timeout_ms) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    const int64_t minDurationNs = static_cast<int64_t>(min_duration_ms) * 1000000;
+
+    std::unique_lock<std::mutex> lock(g_thumbMutex);
+    while (true) {
+        const int64_t since = StableSinceLocked(threshold);
+        auto wakeAt = deadline;
+        if (since >= 0) {
+            const int64_t remainNs = since + minDurationNs - MonotonicNowNs();
+            if (remainNs <= 0) {
+                return 1;
+            }
+            wakeAt = std::min(wakeAt, std::chrono::steady_clock::now() +
+                                      std::chrono::nanoseconds(remainNs));
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return 0;
+        }
+        g_thumbCv.wait_until(lock, wakeAt);
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef BRIDGE_SCREEN_STATE_H
+#define BRIDGE_SCREEN_STATE_H
+
+#include "bridge_frame_buffer.h"
+
+#define SCREEN_THUMB_WIDTH 64
+#define SCREEN_THUMB_HEIGHT 36
+
+extern const FrameAnalyzer kScreenStateAnalyzer;
+
+#endif // BRIDGE_SCREEN_STATE_H
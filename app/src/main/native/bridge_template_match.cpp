@@ -0,0 +1,369 @@
+#include "bridge_frame_buffer.h"
+#include "bridge_luma_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 向量化每次处理 8 列，模板与搜索区域按 8 对齐补零
+#define MATCH_LANES 8
+#define MATCH_MAX_THREADS 4
+#define MATCH_MIN_OPS_PER_THREAD (4 * 1024 * 1024)
+
+struct MatchTemplateData {
+    int width = 0;
+    int height = 0;
+    int padded_width = 0;
+    std::vector<int16_t> zero_mean;
+    double mean_error = 0;
+    double norm = 0;
+};
+
+struct MatchJob {
+    const MatchTemplateData *tpl;
+    const uint8_t *luma;
+    int stride;
+    int width;
+    int positions_x;
+};
+
+struct MatchBest {
+    float score = -2.0f;
+    int x = -1;
+    int y = -1;
+};
+
+// 常驻工作线程，首次需要并行时创建；调用线程处理第 0 块，其余块由工作线程领取。
+// 同一时间只服务一次匹配，并发调用拿不到时在调用线程内串行完成
+struct MatchPool {
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    const MatchJob *job = nullptr;
+    MatchBest *bests = nullptr;
+    int rows = 0;
+    int chunk = 0;
+    int blocks = 0;
+    int next_block = 0;
+    int pending = 0;
+};
+
+// 工作线程常驻，进程退出时仍在等待，池对象不析构
+static MatchPool &g_matchPool = *new MatchPool();
+static std::mutex g_matchRunMutex;
+static std::once_flag g_matchWorkersOnce;
+static int g_matchWorkerCount = 0;
+
+static std::mutex g_templateMutex;
+static std::unordered_map<int, std::shared_ptr<const MatchTemplateData>> g_templates;
+static int g_nextTemplateId = 1;
+
+static int32_t DotRow(const int16_t *__restrict t, const uint8_t *__restrict s, int padded_width) {
+    int x = 0;
+    int32_t acc = 0;
+#if defined(__ARM_NEON)
+    int32x4_t vacc = vdupq_n_s32(0);
+    for (; x < padded_width; x += MATCH_LANES) {
+        int16x8_t img = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(s + x)));
+        int16x8_t tv = vld1q_s16(t + x);
+        vacc = vmlal_s16(vacc, vget_low_s16(tv), vget_low_s16(img));
+        vacc = vmlal_s16(vacc, vget_high_s16(tv), vget_high_s16(img));
+    }
+    acc = vaddvq_s32(vacc);
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i vacc = _mm_setzero_si128();
+    for (; x < padded_width; x += MATCH_LANES) {
+        __m128i img = _mm_unpacklo_epi8(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(s + x)), zero);
+        __m128i tv = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t + x));
+        vacc = _mm_add_epi32(vacc, _mm_madd_epi16(tv, img));
+    }
+    vacc = _mm_add_epi32(vacc, _mm_shuffle_epi32(vacc, _MM_SHUFFLE(1, 0, 3, 2)));
+    vacc = _mm_add_epi32(vacc, _mm_shuffle_epi32(vacc, _MM_SHUFFLE(2, 3, 0, 1)));
+    acc = _mm_cvtsi128_si32(vacc);
+#else
+    for (; x < padded_width; ++x) {
+        acc += t[x] * s[x];
+    }
+#endif
+    return acc;
+}
+
+// 窗口和由列和滑动得到：列和覆盖模板高度，下移一行时减去首行、加上新行
+static void MatchRows(const MatchJob &job, int row_begin, int row_end, MatchBest *best) {
+    const MatchTemplateData &tpl = *job.tpl;
+    const double n = static_cast<double>(tpl.width) * tpl.height;
+    thread_local std::vector<uint32_t> colSum;
+    thread_local std::vector<uint32_t> colSq;
+    colSum.assign(job.width, 0);
+    colSq.assign(job.width, 0);
+    for (int r = 0; r < tpl.height; ++r) {
+        const uint8_t *row = job.luma + static_cast<size_t>(row_begin + r) * job.stride;
+        for (int x = 0; x < job.width; ++x) {
+            colSum[x] += row[x];
+            colSq[x] += row[x] * row[x];
+        }
+    }
+
+    for (int y = row_begin; y < row_end; ++y) {
+        if (y > row_begin) {
+            const uint8_t *out = job.luma + static_cast<size_t>(y - 1) * job.stride;
+            const uint8_t *in = job.luma + static_cast<size_t>(y + tpl.height - 1) * job.stride;
+            for (int x = 0; x < job.width; ++x) {
+                colSum[x] += in[x] - out[x];
+                colSq[x] += in[x] * in[x] - out[x] * out[x];
+            }
+        }
+
+        uint64_t winSum = 0;
+        uint64_t winSq = 0;
+        for (int x = 0; x < tpl.width; ++x) {
+            winSum += colSum[x];
+            winSq += colSq[x];
+        }
+        for (int x = 0; x < job.positions_x; ++x) {
+            if (x > 0) {
+                winSum += colSum[x + tpl.width - 1];
+                winSum -= colSum[x - 1];
+                winSq += colSq[x + tpl.width - 1];
+                winSq -= colSq[x - 1];
+            }
+            const double sum = static_cast<double>(winSum);
+            const double sq = static_cast<double>(winSq);
+            const double variance = sq - sum * sum / n;
+            if (variance <= 0) {
+                continue;
+            }
+
+            int64_t dot = 0;
+            const uint8_t *s = job.luma + static_cast<size_t>(y) * job.stride + x;
+            const int16_t *t = tpl.zero_mean.data();
+            for (int r = 0; r < tpl.height; ++r) {
+                dot += DotRow(t, s, tpl.padded_width);
+                t += tpl.padded_width;
+                s += job.stride;
+            }
+
+            // 模板按取整后的均值去均值，这里补回 mean_error * sum 的偏差
+            const double centered = static_cast<double>(dot) - tpl.mean_error * sum;
+            const float score = static_cast<float>(centered /
+                                                   std::sqrt(variance * tpl.norm));
+            if (score > best->score) {
+                best->score = score;
+                best->x = x;
+                best->y = y;
+            }
+        }
+    }
+}
+
+static void MatchWorkerLoop() {
+    MatchPool &pool = g_matchPool;
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    while (true) {
+        pool.work_cv.wait(lock, [&pool] { return pool.next_block < pool.blocks; });
+        const int block = pool.next_block++;
+        const MatchJob *job = pool.job;
+        MatchBest *best = &pool.bests[block];
+        const int begin = block * pool.chunk;
+        const int end = std::min(pool.rows, begin + pool.chunk);
+        lock.unlock();
+        MatchRows(*job, begin, end, best);
+        lock.lock();
+        if (--pool.pending == 0) {
+            pool.done_cv.notify_all();
+        }
+    }
+}
+
+// 返回可用的工作线程数
+static int EnsureMatchWorkers() {
+    std::call_once(g_matchWorkersOnce, [] {
+        const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        const int count = std::max(0, std::min(MATCH_MAX_THREADS, hardware) - 1);
+        for (int i = 0; i < count; ++i) {
+            std::thread(MatchWorkerLoop).detach();
+        }
+        g_matchWorkerCount = count;
+    });
+    return g_matchWorkerCount;
+}
+
+// 按行分块，blocks 为 1 或工作线程忙时全部在调用线程内完成
+static void RunMatch(const MatchJob &job, int rows, int blocks, MatchBest *bests) {
+    std::unique_lock<std::mutex> run(g_matchRunMutex, std::defer_lock);
+    if (blocks > 1) {
+        blocks = std::min(blocks, EnsureMatchWorkers() + 1);
+    }
+    if (blocks <= 1 || !run.try_lock()) {
+        MatchRows(job, 0, rows, &bests[0]);
+        return;
+    }
+
+    MatchPool &pool = g_matchPool;
+    const int chunk = (rows + blocks - 1) / blocks;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.job = &job;
+        pool.bests = bests;
+        pool.rows = rows;
+        pool.chunk = chunk;
+        pool.blocks = blocks;
+        pool.next_block = 1;
+        pool.pending = blocks - 1;
+    }
+    pool.work_cv.notify_all();
+    MatchRows(job, 0, std::min(rows, chunk), &bests[0]);
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.done_cv.wait(lock, [&pool] { return pool.pending == 0; });
+    pool.blocks = 0;
+    pool.next_block = 0;
+    pool.job = nullptr;
+    pool.bests = nullptr;
+}
+
+BRIDGE_API int RegisterTemplate(const uint8_t *bgr, int width, int height, int stride) {
+    if (!bgr || width <= 0 || height <= 0 || stride < width * 3) {
+        return -1;
+    }
+
+    auto tpl = std::make_shared<MatchTemplateData>();
+    tpl->width = width;
+    tpl->height = height;
+    tpl->padded_width = (width + MATCH_LANES - 1) / MATCH_LANES * MATCH_LANES;
+    tpl->zero_mean.assign(static_cast<size_t>(tpl->padded_width) * height, 0);
+
+    std::vector<uint8_t> luma(static_cast<size_t>(width) * height);
+    uint64_t total = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t *row = bgr + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            luma[y * width + x] = static_cast<uint8_t>(BgrToLuma(row + x * 3));
+            total += luma[y * width + x];
+        }
+    }
+
+    // 均值取整，保证零均值模板能放进 int16；残差在 norm 中一并计入
+    const int mean = static_cast<int>((total + luma.size() / 2) / luma.size());
+    double norm = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int v = luma[y * width + x] - mean;
+            tpl->zero_mean[static_cast<size_t>(y) * tpl->padded_width + x] = static_cast<int16_t>(v);
+            norm += static_cast<double>(v) * v;
+        }
+    }
+    tpl->mean_error = static_cast<double>(total) / luma.size() - mean;
+    tpl->norm = norm - tpl->mean_error * tpl->mean_error * luma.size();
+    if (tpl->norm <= 0) {
+        LOGW("RegisterTemplate: flat template %dx%d rejected", width, height);
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(g_templateMutex);
+    const int id = g_nextTemplateId++;
+    g_templates[id] = std::move(tpl);
+    return id;
+}
+
+BRIDGE_API int UnregisterTemplate(int template_id) {
+    std::lock_guard<std::mutex> lock(g_templateMutex);
+    return g_templates.erase(template_id) ? 0 : -1;
+}
+
+BRIDGE_API int MatchTemplate(int template_id, const RoiRect *roi, TemplateMatchResult *result) {
+    if (!result) {
+        return -1;
+    }
+    *result = TemplateMatchResult{0, -1, -1};
+
+    std::shared_ptr<const MatchTemplateData> tpl;
+    {
+        std::lock_guard<std::mutex> lock(g_templateMutex);
+        auto it = g_templates.find(template_id);
+        if (it == g_templates.end()) {
+            return -1;
+        }
+        tpl = it->second;
+    }
+
+    const FrameBuffer *frame = LockCurrentFrame();
+    if (!frame) {
+        return -1;
+    }
+
+    if (!frame->bgr_data) {
+        UnlockFrame(frame);
+        return -1;
+    }
+
+    RoiRect area = roi ? *roi : RoiRect{0, 0, frame->width, frame->height};
+    const int x0 = std::max(area.x, 0);
+    const int y0 = std::max(area.y, 0);
+    const int x1 = static_cast<int>(
+            std::min<int64_t>(static_cast<int64_t>(area.x) + area.width, frame->width));
+    const int y1 = static_cast<int>(
+            std::min<int64_t>(static_cast<int64_t>(area.y) + area.height, frame->height));
+    const int rw = x1 - x0;
+    const int rh = y1 - y0;
+    if (rw < tpl->width || rh < tpl->height) {
+        UnlockFrame(frame);
+        return 0;
+    }
+
+    // 持锁期间直接从帧缓冲把搜索区域转成亮度，匹配在解锁后进行；亮度缓冲按线程复用。
+    // 行尾留出余量以便向量化越过模板右边界读取，余量内容与补零的模板系数相乘后为 0
+    const int stride = rw + MATCH_LANES;
+    thread_local std::vector<uint8_t> luma;
+    if (luma.size() < static_cast<size_t>(stride) * rh) {
+        luma.resize(static_cast<size_t>(stride) * rh);
+    }
+    for (int y = 0; y < rh; ++y) {
+        const uint8_t *src =
+                frame->bgr_data + (static_cast<size_t>(y + y0) * frame->width + x0) * 3;
+        uint8_t *dst = luma.data() + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < rw; ++x) {
+            dst[x] = static_cast<uint8_t>(BgrToLuma(src + x * 3));
+        }
+    }
+    UnlockFrame(frame);
+
+    MatchJob job{tpl.get(), luma.data(), stride, rw, rw - tpl->width + 1};
+    const int rows = rh - tpl->height + 1;
+    const int64_t ops = static_cast<int64_t>(rows) * job.positions_x * tpl->padded_width *
+                        tpl->height;
+    int threads = static_cast<int>(std::min<int64_t>(ops / MATCH_MIN_OPS_PER_THREAD + 1,
+                                                     MATCH_MAX_THREADS));
+    threads = std::max(1, std::min(threads, rows));
+
+    MatchBest bests[MATCH_MAX_THREADS];
+    RunMatch(job, rows, threads, bests);
+
+    MatchBest best;
+    for (int i = 0; i < threads; ++i) {
+        if (bests[i].score > best.score) {
+            best = bests[i];
+        }
+    }
+    if (best.x < 0) {
+        return 0;
+    }
+
+    result->score = best.score;
+    result->x = best.x + x0;
+    result->y = best.y + y0;
+    return 1;
+}
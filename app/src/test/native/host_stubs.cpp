@@ -0,0 +1,18 @@
+// 主机测试共用的 NDK 函数替身
+#include <android/log.h>
+
+#include <cstdarg>
+#include <cstdio>
+
+extern "C" int __android_log_print(int prio, const char *tag, const char *fmt, ...) {
+    if (prio < ANDROID_LOG_WARN) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "[%s] ", tag);
+    const int written = vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return written;
+}
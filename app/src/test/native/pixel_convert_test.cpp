@@ -0,0 +1,168 @@
+// SIMD 转换与同一文件中的标量尾部逐位比较：宽度为 1 的调用不会进入向量循环，
+// 逐像素调用即得到标量结果
+#include "bridge_pixel_convert.cpp"
+
+#include "test_util.h"
+
+#include <cstring>
+
+static constexpr uint8_t kGuard = 0xA5;
+static constexpr int kGuardBytes = 32;
+
+// 目标行之后留哨兵字节，检查向量写入不越过 width * 3
+static void CheckRow(const char *name, int width, const std::vector<uint8_t> &simd,
+                     const std::vector<uint8_t> &scalar) {
+    for (int i = 0; i < width * 3; ++i) {
+        CHECK_MSG(simd[i] == scalar[i], "%s width=%d pixel=%d channel=%d simd=%d scalar=%d",
+                  name, width, i / 3, i % 3, simd[i], scalar[i]);
+    }
+    for (int i = width * 3; i < width * 3 + kGuardBytes; ++i) {
+        CHECK_MSG(simd[i] == kGuard, "%s width=%d wrote past row end at byte %d", name, width,
+                  i);
+    }
+}
+
+static std::vector<uint8_t> GuardedRow(int width) {
+    return std::vector<uint8_t>(static_cast<size_t>(width) * 3 + kGuardBytes, kGuard);
+}
+
+static void TestRgba(TestRandom &rng, int width, int stride_pad, int offset) {
+    const int height = 3;
+    const int stride = width * 4 + stride_pad;
+    std::vector<uint8_t> data(static_cast<size_t>(stride) * height + offset + 64);
+    rng.Fill(data);
+    const uint8_t *base = data.data() + offset;
+
+    for (CapturePixelFormat format : {CAPTURE_FORMAT_RGBA_8888, CAPTURE_FORMAT_RGBX_8888}) {
+        const FrameSource src = {format, {base}, {stride}, {4}};
+        for (int y = 0; y < height; ++y) {
+            std::vector<uint8_t> simd = GuardedRow(width);
+            std::vector<uint8_t> scalar = GuardedRow(width);
+            ConvertSourceRowToBgr(&src, y, simd.data(), width);
+            const uint8_t *row = base + static_cast<size_t>(y) * stride;
+            for (int x = 0; x < width; ++x) {
+                ConvertRowRgbaToBgr(row + x * 4, scalar.data() + x * 3, 1);
+            }
+            CheckRow("rgba", width, simd, scalar);
+        }
+    }
+}
+
+static void TestRgb565(TestRandom &rng, int width, int stride_pad, int offset) {
+    const int height = 3;
+    const int stride = width * 2 + stride_pad;
+    std::vector<uint8_t> data(static_cast<size_t>(stride) * height + offset + 64);
+    rng.Fill(data);
+    const uint8_t *base = data.data() + offset;
+    const FrameSource src = {CAPTURE_FORMAT_RGB_565, {base}, {stride}, {2}};
+
+    for (int y = 0; y < height; ++y) {
+        std::vector<uint8_t> simd = GuardedRow(width);
+        std::vector<uint8_t> scalar = GuardedRow(width);
+        ConvertSourceRowToBgr(&src, y, simd.data(), width);
+        const uint8_t *row = base + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            ConvertRowRgb565ToBgr(row + x * 2, scalar.data() + x * 3, 1);
+        }
+        CheckRow("rgb565", width, simd, scalar);
+    }
+}
+
+// 半平面 YUV；extreme 时亮度和色度只取 0/16/235/255 等边界值，覆盖饱和路径
+static void TestNv12(TestRandom &rng, int width, int stride_pad, int offset, bool vu_order,
+                     bool extreme) {
+    const int height = 4;
+    const int yStride = width + stride_pad;
+    const int uvStride = ((width + 1) & ~1) + stride_pad;
+    std::vector<uint8_t> yPlane(static_cast<size_t>(yStride) * height + offset + 64);
+    std::vector<uint8_t> uvPlane(static_cast<size_t>(uvStride) * (height / 2) + offset + 64);
+    rng.Fill(yPlane);
+    rng.Fill(uvPlane);
+    if (extreme) {
+        static const uint8_t kEdges[] = {0, 1, 15, 16, 128, 235, 240, 254, 255};
+        for (uint8_t &b : yPlane) b = kEdges[rng.Next() % sizeof(kEdges)];
+        for (uint8_t &b : uvPlane) b = kEdges[rng.Next() % sizeof(kEdges)];
+    }
+    const uint8_t *y0 = yPlane.data() + offset;
+    const uint8_t *uv0 = uvPlane.data() + offset;
+    const uint8_t *u = vu_order ? uv0 + 1 : uv0;
+    const uint8_t *v = vu_order ? uv0 : uv0 + 1;
+    const FrameSource src = {CAPTURE_FORMAT_YUV_420_888, {y0, u, v},
+                             {yStride, uvStride, uvStride}, {1, 2, 2}};
+
+    for (int y = 0; y < height; ++y) {
+        std::vector<uint8_t> simd = GuardedRow(width);
+        std::vector<uint8_t> scalar = GuardedRow(width);
+        std::vector<uint8_t> planar = GuardedRow(width);
+        ConvertSourceRowToBgr(&src, y, simd.data(), width);
+
+        const uint8_t *yRow = y0 + static_cast<size_t>(y) * yStride;
+        const uint8_t *uvRow = uv0 + static_cast<size_t>(y >> 1) * uvStride;
+        for (int x = 0; x < width; ++x) {
+            ConvertRowNv12ToBgr(yRow + x, uvRow + (x & ~1), scalar.data() + x * 3, 1, vu_order);
+        }
+        CheckRow(vu_order ? "nv21" : "nv12", width, simd, scalar);
+
+        // 通用平面路径只有标量实现，同一数据按任意步长解读结果也应一致
+        ConvertRowYuvPlanarToBgr(yRow, u + (y >> 1) * uvStride, v + (y >> 1) * uvStride, 2, 2,
+                                 planar.data(), width);
+        CheckRow("yuv planar", width, simd, planar);
+    }
+}
+
+// 步长不为 2 的 I420 只走标量，确认分派正确
+static void TestI420(TestRandom &rng, int width) {
+    const int height = 2;
+    const int cw = (width + 1) / 2;
+    std::vector<uint8_t> yPlane(static_cast<size_t>(width) * height);
+    std::vector<uint8_t> uPlane(cw);
+    std::vector<uint8_t> vPlane(cw);
+    rng.Fill(yPlane);
+    rng.Fill(uPlane);
+    rng.Fill(vPlane);
+    const FrameSource src = {CAPTURE_FORMAT_YUV_420_888,
+                             {yPlane.data(), uPlane.data(), vPlane.data()},
+                             {width, cw, cw}, {1, 1, 1}};
+
+    for (int y = 0; y < height; ++y) {
+        std::vector<uint8_t> out = GuardedRow(width);
+        std::vector<uint8_t> expected = GuardedRow(width);
+        ConvertSourceRowToBgr(&src, y, out.data(), width);
+        for (int x = 0; x < width; ++x) {
+            YuvToBgrPixel(yPlane[y * width + x], uPlane[x / 2], vPlane[x / 2],
+                          expected.data() + x * 3);
+        }
+        CheckRow("i420", width, out, expected);
+    }
+}
+
+int main() {
+    TestRandom rng(0x5EED037u);
+    for (int width = 1; width <= 70; ++width) {
+        for (int pad : {0, 1, 7, 64}) {
+            const int offset = width % 4;
+            TestRgba(rng, width, pad * 4, offset);
+            TestRgb565(rng, width, pad * 2 + (pad & 1), offset);
+            TestNv12(rng, width, pad, offset, false, false);
+            TestNv12(rng, width, pad, offset, true, false);
+            TestNv12(rng, width, pad, offset, false, true);
+            TestNv12(rng, width, pad, offset, true, true);
+        }
+        TestI420(rng, width);
+    }
+    for (int width : {720, 1079, 1080, 1920, 2400}) {
+        TestRgba(rng, width, 0, 0);
+        TestRgb565(rng, width, 0, 0);
+        TestNv12(rng, width, 32, 0, false, true);
+        TestNv12(rng, width, 32, 0, true, false);
+    }
+
+#if defined(__ARM_NEON)
+    puts("pixel_convert_test: NEON vs scalar OK");
+#elif defined(__SSSE3__)
+    puts("pixel_convert_test: SSSE3 vs scalar OK");
+#else
+    puts("pixel_convert_test: scalar only, no SIMD path compiled");
+#endif
+    return 0;
+}
@@ -0,0 +1,263 @@
+// CPU 预览回退：ScaleBgrRowToRgbx 各倍数（1~8）的 SIMD 路径与同一文件中的标量尾部逐像素比较，
+// BlitFrameToWindow 经内存窗口检查缩小倍数选择、居中、黑边、stride 和加锁 / 提交配对
+#include "bridge_preview_blit.cpp"
+
+#include "test_util.h"
+
+#include <cstring>
+
+static constexpr uint8_t kGuard = 0xA5;
+static constexpr int kGuardBytes = 64;
+static constexpr uint32_t kSentinel = 0x12345678u;
+
+static uint32_t ExpectedPixel(const uint8_t *bgr) {
+    return 0xFF000000u | static_cast<uint32_t>(bgr[0]) << 16 |
+           static_cast<uint32_t>(bgr[1]) << 8 | bgr[2];
+}
+
+// 源行恰好 width * step 个像素，放在堆块末尾，越界读取由 ASan 构建发现
+static void TestScaleRow(TestRandom &rng, int width, int step) {
+    std::vector<uint8_t> src(static_cast<size_t>(width) * step * 3);
+    rng.Fill(src);
+    std::vector<uint8_t> simd(static_cast<size_t>(width) * 4 + kGuardBytes, kGuard);
+    std::vector<uint8_t> scalar(simd.size(), kGuard);
+
+    ScaleBgrRowToRgbx(src.data(), simd.data(), width, step);
+    // 宽度为 1 的调用不进入向量循环
+    for (int x = 0; x < width; ++x) {
+        ScaleBgrRowToRgbx(src.data() + static_cast<size_t>(x) * step * 3, scalar.data() + x * 4, 1,
+                          step);
+    }
+    for (int x = 0; x < width; ++x) {
+        uint32_t a;
+        uint32_t b;
+        memcpy(&a, simd.data() + x * 4, 4);
+        memcpy(&b, scalar.data() + x * 4, 4);
+        CHECK_MSG(a == b, "step=%d width=%d pixel=%d simd=%08x scalar=%08x", step, width, x, a, b);
+        CHECK_MSG(b == ExpectedPixel(src.data() + static_cast<size_t>(x) * step * 3),
+                  "step=%d width=%d pixel=%d scalar=%08x", step, width, x, b);
+    }
+    for (size_t i = static_cast<size_t>(width) * 4; i < simd.size(); ++i) {
+        CHECK_MSG(simd[i] == kGuard, "step=%d width=%d wrote past row end at byte %zu", step,
+                  width, i);
+    }
+}
+
+struct MemoryWindow {
+    std::vector<uint32_t> pixels;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    bool fail_lock = false;
+    bool null_pixels = false;
+    int locks = 0;
+    int posts = 0;
+};
+
+static bool LockMemoryWindow(void *ctx, BlitTarget *target) {
+    auto *window = static_cast<MemoryWindow *>(ctx);
+    ++window->locks;
+    if (window->fail_lock) {
+        return false;
+    }
+    target->pixels = window->null_pixels ? nullptr : window->pixels.data();
+    target->width = window->width;
+    target->height = window->height;
+    target->stride = window->stride;
+    return true;
+}
+
+static void PostMemoryWindow(void *ctx) {
+    ++static_cast<MemoryWindow *>(ctx)->posts;
+}
+
+static const BlitWindowOps kMemoryWindowOps = {LockMemoryWindow, PostMemoryWindow};
+
+static MemoryWindow MakeWindow(int width, int height, int stride) {
+    MemoryWindow window;
+    window.width = width;
+    window.height = height;
+    window.stride = stride;
+    window.pixels.assign(static_cast<size_t>(stride) * height, kSentinel);
+    return window;
+}
+
+// 满足 width / step <= 窗口宽、height / step <= 窗口高的最小整数
+static int ExpectedStep(int width, int height, const MemoryWindow &window) {
+    int step = 1;
+    while (width / step > window.width || height / step > window.height) {
+        ++step;
+    }
+    return step;
+}
+
+// 逐像素按参考实现比较；stride 之外的填充区必须保持原值
+static int CheckBlit(const char *name, const std::vector<uint8_t> &src, int width, int height,
+                     int src_stride, const MemoryWindow &window) {
+    const int step = ExpectedStep(width, height, window);
+    const int outWidth = width / step;
+    const int outHeight = height / step;
+    const int outX = (window.width - outWidth) / 2;
+    const int outY = (window.height - outHeight) / 2;
+    for (int y = 0; y < window.height; ++y) {
+        for (int x = 0; x < window.stride; ++x) {
+            uint32_t expected = kSentinel;
+            if (x < window.width) {
+                expected = 0xFF000000u;
+                if (x >= outX && x < outX + outWidth && y >= outY && y < outY + outHeight) {
+                    expected = ExpectedPixel(src.data() +
+                                             static_cast<size_t>(y - outY) * step * src_stride +
+                                             static_cast<size_t>(x - outX) * step * 3);
+                }
+            }
+            const uint32_t actual = window.pixels[static_cast<size_t>(y) * window.stride + x];
+            CHECK_MSG(actual == expected,
+                      "%s: src %dx%d window %dx%d stride %d step %d: (%d,%d) = %08x, expected %08x",
+                      name, width, height, window.width, window.height, window.stride, step, x, y,
+                      actual, expected);
+        }
+    }
+    CHECK_MSG(window.locks == 1 && window.posts == 1, "%s: locks=%d posts=%d", name, window.locks,
+              window.posts);
+    return step;
+}
+
+static int Blit(const char *name, TestRandom &rng, int width, int height, int src_pad,
+                MemoryWindow &window) {
+    const int srcStride = width * 3 + src_pad;
+    std::vector<uint8_t> src(static_cast<size_t>(srcStride) * height);
+    rng.Fill(src);
+    CHECK(BlitFrameToWindow(&kMemoryWindowOps, &window, src.data(), width, height, srcStride));
+    return CheckBlit(name, src, width, height, srcStride, window);
+}
+
+static void TestStepSelection(TestRandom &rng) {
+    struct Case {
+        int width;
+        int height;
+        int windowWidth;
+        int windowHeight;
+        int step;
+    };
+    const Case cases[] = {
+            {100, 50, 100, 50, 1},
+            {60, 30, 100, 50, 1},
+            {101, 50, 100, 50, 2},
+            {200, 100, 100, 50, 2},
+            {201, 100, 100, 50, 2},
+            {202, 100, 100, 50, 3},
+            {100, 51, 100, 50, 2},
+            {50, 300, 100, 100, 3},
+            {1280, 720, 320, 180, 4},
+            {1280, 720, 321, 181, 4},
+            {1280, 720, 319, 180, 5},
+    };
+    for (const Case &c : cases) {
+        MemoryWindow window = MakeWindow(c.windowWidth, c.windowHeight, c.windowWidth);
+        const int step = Blit("step", rng, c.width, c.height, 0, window);
+        CHECK_MSG(step == c.step, "src %dx%d window %dx%d: step %d, expected %d", c.width,
+                  c.height, c.windowWidth, c.windowHeight, step, c.step);
+    }
+}
+
+// 画面居中，奇数余量时左 / 上少一列；这里用写死的偏移，不依赖参考实现的公式
+static void TestCentring(TestRandom &rng) {
+    struct Case {
+        int windowWidth;
+        int windowHeight;
+        int stride;
+        int srcPad;
+        int outX;
+        int outY;
+    };
+    const Case cases[] = {
+            {20, 14, 24, 0, 5, 2},
+            {21, 15, 21, 9, 5, 2},
+            {10, 10, 16, 3, 0, 0},
+    };
+    for (const Case &c : cases) {
+        const int srcStride = 10 * 3 + c.srcPad;
+        std::vector<uint8_t> src(static_cast<size_t>(srcStride) * 10);
+        rng.Fill(src);
+        MemoryWindow window = MakeWindow(c.windowWidth, c.windowHeight, c.stride);
+        CHECK(BlitFrameToWindow(&kMemoryWindowOps, &window, src.data(), 10, 10, srcStride));
+        CheckBlit("centre", src, 10, 10, srcStride, window);
+        auto at = [&window](int x, int y) {
+            return window.pixels[static_cast<size_t>(y) * window.stride + x];
+        };
+        CHECK(at(c.outX, c.outY) == ExpectedPixel(src.data()));
+        CHECK(at(c.outX + 9, c.outY + 9) ==
+              ExpectedPixel(src.data() + static_cast<size_t>(9) * srcStride + 9 * 3));
+        if (c.outX > 0) {
+            CHECK(at(c.outX - 1, c.outY) == 0xFF000000u);
+        }
+        if (c.outY > 0) {
+            CHECK(at(c.outX, c.outY - 1) == 0xFF000000u);
+        }
+        if (c.outX + 10 < c.windowWidth) {
+            CHECK(at(c.outX + 10, c.outY + 9) == 0xFF000000u);
+        }
+        if (c.outY + 10 < c.windowHeight) {
+            CHECK(at(c.outX + 9, c.outY + 10) == 0xFF000000u);
+        }
+    }
+}
+
+static void TestFailures(TestRandom &rng) {
+    std::vector<uint8_t> src(64 * 3);
+    rng.Fill(src);
+
+    MemoryWindow locked = MakeWindow(8, 8, 8);
+    locked.fail_lock = true;
+    CHECK(!BlitFrameToWindow(&kMemoryWindowOps, &locked, src.data(), 8, 8, 24));
+    CHECK(locked.locks == 1 && locked.posts == 0);
+
+    // 加锁成功后无论结果如何都要提交
+    MemoryWindow empty = MakeWindow(8, 8, 8);
+    empty.null_pixels = true;
+    CHECK(!BlitFrameToWindow(&kMemoryWindowOps, &empty, src.data(), 8, 8, 24));
+    CHECK(empty.locks == 1 && empty.posts == 1);
+
+    MemoryWindow zero = MakeWindow(0, 8, 8);
+    CHECK(!BlitFrameToWindow(&kMemoryWindowOps, &zero, src.data(), 8, 8, 24));
+    CHECK(zero.locks == 1 && zero.posts == 1);
+
+    MemoryWindow untouched = MakeWindow(8, 8, 8);
+    CHECK(!BlitFrameToWindow(&kMemoryWindowOps, &untouched, src.data(), 0, 8, 24));
+    CHECK(!BlitFrameToWindow(&kMemoryWindowOps, &untouched, nullptr, 8, 8, 24));
+    CHECK(!BlitFrameToWindow(nullptr, &untouched, src.data(), 8, 8, 24));
+    CHECK(untouched.locks == 0 && untouched.posts == 0);
+}
+
+int main() {
+    TestRandom rng(0xB117048u);
+    for (int step = 1; step <= 8; ++step) {
+        for (int width = 1; width <= 70; ++width) {
+            TestScaleRow(rng, width, step);
+        }
+        for (int width : {318, 319, 320, 640, 1079, 1080}) {
+            TestScaleRow(rng, width, step);
+        }
+    }
+
+    TestStepSelection(rng);
+    TestCentring(rng);
+    TestFailures(rng);
+    for (int i = 0; i < 300; ++i) {
+        const int width = rng.Range(1, 300);
+        const int height = rng.Range(1, 200);
+        const int windowWidth = rng.Range(1, 200);
+        MemoryWindow window = MakeWindow(windowWidth, rng.Range(1, 200),
+                                         windowWidth + rng.Range(0, 7));
+        Blit("random", rng, width, height, rng.Range(0, 2) * 3, window);
+    }
+
+#if defined(__ARM_NEON)
+    puts("preview_blit_test: NEON vs scalar OK");
+#elif defined(__SSSE3__)
+    puts("preview_blit_test: SSSE3 vs scalar OK");
+#else
+    puts("preview_blit_test: scalar only, no SIMD path compiled");
+#endif
+    return 0;
+}
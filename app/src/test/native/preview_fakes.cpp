@@ -0,0 +1,82 @@
+// 预览测试共用的 NDK、JNI 和帧缓冲函数替身
+#include "preview_fakes.h"
+
+#include "bridge_frame_buffer.h"
+
+#include <android/native_window_jni.h>
+#include <jni.h>
+
+std::atomic<int> g_fakeLiveWindows{0};
+
+extern "C" {
+
+void AHardwareBuffer_acquire(AHardwareBuffer *buffer) {
+    buffer->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AHardwareBuffer_release(AHardwareBuffer *buffer) {
+    buffer->refs.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AHardwareBuffer_describe(const AHardwareBuffer *buffer, AHardwareBuffer_Desc *desc) {
+    *desc = AHardwareBuffer_Desc();
+    desc->width = buffer->width;
+    desc->height = buffer->height;
+    desc->layers = 1;
+    desc->format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+}
+
+ANativeWindow *ANativeWindow_fromSurface(JNIEnv *env, jobject surface) {
+    if (!surface) {
+        return nullptr;
+    }
+    g_fakeLiveWindows.fetch_add(1, std::memory_order_relaxed);
+    return new ANativeWindow();
+}
+
+void ANativeWindow_acquire(ANativeWindow *window) {
+    window->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ANativeWindow_release(ANativeWindow *window) {
+    if (window->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        g_fakeLiveWindows.fetch_sub(1, std::memory_order_relaxed);
+        delete window;
+    }
+}
+
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *window, int32_t width, int32_t height,
+                                         int32_t format) {
+    return 0;
+}
+
+// 没有可写的缓冲区，CPU 回退路径只走到加锁失败
+int32_t ANativeWindow_lock(ANativeWindow *window, ANativeWindow_Buffer *out_buffer,
+                           ARect *in_out_dirty_bounds) {
+    return -1;
+}
+
+int32_t ANativeWindow_unlockAndPost(ANativeWindow *window) {
+    return 0;
+}
+
+} // extern "C"
+
+jobject _JNIEnv::NewGlobalRef(jobject obj) {
+    return obj;
+}
+
+void _JNIEnv::DeleteGlobalRef(jobject obj) {
+}
+
+jboolean _JNIEnv::IsSameObject(jobject a, jobject b) {
+    return a == b ? JNI_TRUE : JNI_FALSE;
+}
+
+// 没有采集会话，CPU 回退路径取不到帧
+const FrameBuffer *LockCurrentFrame() {
+    return nullptr;
+}
+
+void UnlockFrame(const FrameBuffer *frame) {
+}
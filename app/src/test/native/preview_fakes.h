@@ -0,0 +1,28 @@
+#ifndef BRIDGE_PREVIEW_FAKES_H
+#define BRIDGE_PREVIEW_FAKES_H
+
+#include <android/hardware_buffer.h>
+#include <android/native_window.h>
+
+#include <atomic>
+#include <cstdint>
+
+// 预览测试用的 NDK 对象替身：只记录引用计数和尺寸，引用泄漏或重复释放由测试检查
+
+struct AHardwareBuffer {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // GL 测试中作为 EGLImage 来源的 2D 纹理
+    uint32_t texture = 0;
+    std::atomic<int> refs{0};
+};
+
+// ANativeWindow_fromSurface 每次返回新对象，引用归零时删除
+struct ANativeWindow {
+    std::atomic<int> refs{1};
+};
+
+// 仍未释放的窗口数
+extern std::atomic<int> g_fakeLiveWindows;
+
+#endif // BRIDGE_PREVIEW_FAKES_H
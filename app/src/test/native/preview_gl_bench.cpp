@@ -0,0 +1,78 @@
+// 预览绘制耗时：1280x720 画面按三种缩小路径画到悬浮窗大小的表面上，
+// 分别测缓存命中（读取器缓冲区轮转）和每帧重新导入 EGLImage 的情况。
+// 软件光栅化的绝对值不代表设备，只用于同一台机器上的前后对比
+//   preview_gl_bench [帧数]
+#include "bridge_preview.cpp"
+
+#include "preview_gl_harness.h"
+#include "test_util.h"
+
+#include <cstdlib>
+
+static constexpr int kFrameWidth = 1280;
+static constexpr int kFrameHeight = 720;
+// 与 AImageReader 的缓冲区数相当
+static constexpr int kBufferCount = 4;
+
+static double MeasureMs(AHardwareBuffer *buffers, int frames, bool reimport) {
+    for (int i = 0; i < kBufferCount; ++i) {
+        RenderPreview(&buffers[i], 1);
+    }
+    glFinish();
+    const int64_t start = MonotonicNowNs();
+    for (int i = 0; i < frames; ++i) {
+        if (reimport) {
+            InvalidatePreviewImageCache();
+        }
+        RenderPreview(&buffers[i % kBufferCount], 1);
+        glFinish();
+    }
+    return (MonotonicNowNs() - start) / 1e6 / frames;
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+    if (!InitHeadlessEGL(kFrameWidth / 2, kFrameHeight / 2) || !InitPreviewGL()) {
+        puts("preview_gl_bench: headless EGL unavailable");
+        return kSkipReturnCode;
+    }
+    printf("renderer: %s, %dx%d source, %d frames\n",
+           reinterpret_cast<const char *>(glGetString(GL_RENDERER)), kFrameWidth, kFrameHeight,
+           frames);
+
+    TestRandom rng(0xBE4C042u);
+    std::vector<uint32_t> pixels(static_cast<size_t>(kFrameWidth) * kFrameHeight);
+    AHardwareBuffer buffers[kBufferCount];
+    for (AHardwareBuffer &hb : buffers) {
+        for (uint32_t &p : pixels) {
+            p = rng.Next() | 0xFF000000u;
+        }
+        InitSourceBuffer(&hb, kFrameWidth, kFrameHeight, pixels);
+    }
+
+    struct Case {
+        const char *name;
+        int width;
+        int height;
+    };
+    const Case cases[] = {
+            {"bilinear 1.8x", 720, 405},
+            {"tap 2.7x", 480, 270},
+            {"two-pass 5.3x", 240, 135},
+    };
+    printf("%-16s %10s %10s\n", "path", "cached ms", "import ms");
+    for (const Case &c : cases) {
+        CHECK(MakeHeadlessSurface(c.width, c.height));
+        const double cached = MeasureMs(buffers, frames, false);
+        const double imported = MeasureMs(buffers, frames, true);
+        CHECK(glGetError() == GL_NO_ERROR);
+        printf("%-16s %10.3f %10.3f\n", c.name, cached, imported);
+    }
+
+    ReleaseImageCache();
+    for (AHardwareBuffer &hb : buffers) {
+        glDeleteTextures(1, &hb.texture);
+    }
+    DeinitEGL();
+    return 0;
+}
@@ -0,0 +1,174 @@
+#ifndef BRIDGE_PREVIEW_GL_HARNESS_H
+#define BRIDGE_PREVIEW_GL_HARNESS_H
+
+// 在包含 bridge_preview.cpp 之后包含。窗口表面换成 Mesa surfaceless 平台上的 pbuffer，
+// AHardwareBuffer 的导入换成从 GL 纹理创建 EGLImage，着色器、缓存和绘制路径与设备一致
+
+#include "preview_fakes.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// ctest 按该返回码把测试记为跳过
+static constexpr int kSkipReturnCode = 77;
+
+static EGLConfig g_headlessConfig = nullptr;
+static PFNEGLCREATEIMAGEKHRPROC g_realCreateImage = nullptr;
+static PFNEGLDESTROYIMAGEKHRPROC g_realDestroyImage = nullptr;
+static int g_imagesCreated = 0;
+static int g_imagesDestroyed = 0;
+
+static EGLClientBuffer EGLAPIENTRY FakeGetNativeClientBuffer(const AHardwareBuffer *buffer) {
+    return const_cast<AHardwareBuffer *>(buffer);
+}
+
+// 预览按 EGL_NATIVE_BUFFER_ANDROID 导入且不指定上下文，这里改为导入缓冲区背后的纹理
+static EGLImageKHR EGLAPIENTRY FakeCreateImage(EGLDisplay display, EGLContext context,
+                                               EGLenum target, EGLClientBuffer buffer,
+                                               const EGLint *attribs) {
+    if (target != EGL_NATIVE_BUFFER_ANDROID || context != EGL_NO_CONTEXT || !buffer) {
+        return EGL_NO_IMAGE_KHR;
+    }
+    const auto *hb = static_cast<const AHardwareBuffer *>(buffer);
+    const auto texture = reinterpret_cast<EGLClientBuffer>(static_cast<uintptr_t>(hb->texture));
+    EGLImageKHR image = g_realCreateImage(display, g_eglState.context, EGL_GL_TEXTURE_2D_KHR,
+                                          texture, attribs);
+    if (image != EGL_NO_IMAGE_KHR) {
+        ++g_imagesCreated;
+    }
+    return image;
+}
+
+static EGLBoolean EGLAPIENTRY FakeDestroyImage(EGLDisplay display, EGLImageKHR image) {
+    ++g_imagesDestroyed;
+    return g_realDestroyImage(display, image);
+}
+
+static inline bool HasExtension(const char *extensions, const char *name) {
+    if (!extensions) {
+        return false;
+    }
+    const size_t length = strlen(name);
+    for (const char *p = strstr(extensions, name); p; p = strstr(p + length, name)) {
+        if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool MakeHeadlessSurface(int width, int height) {
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(g_eglState.display, g_headlessConfig,
+                                                 surfaceAttribs);
+    if (surface == EGL_NO_SURFACE) {
+        return false;
+    }
+    if (eglMakeCurrent(g_eglState.display, surface, surface, g_eglState.context) == EGL_FALSE) {
+        eglDestroySurface(g_eglState.display, surface);
+        return false;
+    }
+    if (g_eglState.surface != EGL_NO_SURFACE) {
+        eglDestroySurface(g_eglState.display, g_eglState.surface);
+    }
+    g_eglState.surface = surface;
+    return true;
+}
+
+// 按 InitEGL 的顺序建立上下文并填写 g_eglState，不调用 InitPreviewGL；
+// 缺少 surfaceless 平台、pbuffer 配置或所需扩展时返回 false，调用方按跳过处理
+static inline bool InitHeadlessEGL(int width, int height) {
+    const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless") || !getPlatformDisplay) {
+        fprintf(stderr, "EGL_MESA_platform_surfaceless unavailable\n");
+        return false;
+    }
+    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY,
+                                            nullptr);
+    if (display == EGL_NO_DISPLAY || eglInitialize(display, nullptr, nullptr) == EGL_FALSE) {
+        fprintf(stderr, "surfaceless eglInitialize failed\n");
+        return false;
+    }
+    if (!HasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_gl_texture_2D_image")) {
+        fprintf(stderr, "EGL_KHR_gl_texture_2D_image unavailable\n");
+        eglTerminate(display);
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_BLUE_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_RED_SIZE, 8,
+            EGL_NONE
+    };
+    EGLint numConfigs = 0;
+    const EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE};
+    EGLContext context = EGL_NO_CONTEXT;
+    if (eglChooseConfig(display, configAttribs, &g_headlessConfig, 1, &numConfigs) == EGL_FALSE ||
+        numConfigs <= 0 ||
+        (context = eglCreateContext(display, g_headlessConfig, EGL_NO_CONTEXT, contextAttribs)) ==
+        EGL_NO_CONTEXT) {
+        fprintf(stderr, "no GLES2 pbuffer config\n");
+        eglTerminate(display);
+        return false;
+    }
+    g_eglState.display = display;
+    g_eglState.context = context;
+    if (!MakeHeadlessSurface(width, height) ||
+        !HasExtension(reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS)),
+                      "GL_OES_EGL_image_external")) {
+        fprintf(stderr, "GL_OES_EGL_image_external unavailable\n");
+        g_eglState.initialized = true;
+        DeinitEGL();
+        return false;
+    }
+
+    g_realCreateImage = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+            eglGetProcAddress("eglCreateImageKHR"));
+    g_realDestroyImage = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+            eglGetProcAddress("eglDestroyImageKHR"));
+    glEGLImageTargetTexture2DOES = reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+            eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+    eglGetNativeClientBufferANDROID = FakeGetNativeClientBuffer;
+    eglCreateImageKHR = FakeCreateImage;
+    eglDestroyImageKHR = FakeDestroyImage;
+
+    g_eglState.initialized = true;
+    g_imageCacheSeenGeneration = g_imageCacheGeneration.load(std::memory_order_acquire);
+    return g_realCreateImage && g_realDestroyImage && glEGLImageTargetTexture2DOES;
+}
+
+// 用 RGBA 像素（行 0 为画面顶部）建立缓冲区背后的纹理
+static inline void InitSourceBuffer(AHardwareBuffer *hb, int width, int height,
+                             const std::vector<uint32_t> &pixels) {
+    hb->width = static_cast<uint32_t>(width);
+    hb->height = static_cast<uint32_t>(height);
+    if (!hb->texture) {
+        glGenTextures(1, &hb->texture);
+    }
+    glBindTexture(GL_TEXTURE_2D, hb->texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 pixels.data());
+}
+
+// y 从表面顶部算起，返回小端 RGBA
+static inline uint32_t ReadSurfacePixel(int x, int y) {
+    EGLint height = 0;
+    eglQuerySurface(g_eglState.display, g_eglState.surface, EGL_HEIGHT, &height);
+    uint32_t pixel = 0;
+    glReadPixels(x, height - 1 - y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &pixel);
+    return pixel;
+}
+
+#endif // BRIDGE_PREVIEW_GL_HARNESS_H
@@ -0,0 +1,201 @@
+// 在 Mesa surfaceless 上下文中运行预览的 GL 初始化和绘制路径：着色器编译链接、
+// 双线性 / 单级 / 两级 4 点采样的选择、等比居中与黑边、画面方向，以及 EGLImage 缓存
+#include "bridge_preview.cpp"
+
+#include "preview_gl_harness.h"
+#include "test_util.h"
+
+#include <cstdlib>
+
+static constexpr uint32_t kRed = 0xFF0000FFu;
+static constexpr uint32_t kGreen = 0xFF00FF00u;
+static constexpr uint32_t kBlue = 0xFFFF0000u;
+static constexpr uint32_t kWhite = 0xFFFFFFFFu;
+static constexpr uint32_t kBlack = 0xFF000000u;
+
+// 左上红、右上绿、左下蓝、右下白
+static std::vector<uint32_t> QuadrantPixels(int width, int height) {
+    std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const bool right = x >= width / 2;
+            const bool bottom = y >= height / 2;
+            pixels[static_cast<size_t>(y) * width + x] =
+                    bottom ? (right ? kWhite : kBlue) : (right ? kGreen : kRed);
+        }
+    }
+    return pixels;
+}
+
+// mediump 插值和多点平均允许少量误差
+static bool SameColor(uint32_t a, uint32_t b) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (abs(static_cast<int>((a >> shift) & 0xFF) - static_cast<int>((b >> shift) & 0xFF)) > 3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void CheckPixel(const char *name, int x, int y, uint32_t expected) {
+    const uint32_t actual = ReadSurfacePixel(x, y);
+    CHECK_MSG(SameColor(actual, expected), "%s: pixel (%d,%d) = %08x, expected %08x", name, x, y,
+              actual, expected);
+}
+
+// 画面应占据 [viewX, viewX + viewWidth) x [viewY, viewY + viewHeight)，其余为黑
+static void CheckLayout(const char *name, int surfaceWidth, int surfaceHeight, int viewX,
+                        int viewY, int viewWidth, int viewHeight) {
+    CHECK_MSG(glGetError() == GL_NO_ERROR, "%s: GL error", name);
+    const int qx = viewWidth / 4;
+    const int qy = viewHeight / 4;
+    CheckPixel(name, viewX + qx, viewY + qy, kRed);
+    CheckPixel(name, viewX + viewWidth - 1 - qx, viewY + qy, kGreen);
+    CheckPixel(name, viewX + qx, viewY + viewHeight - 1 - qy, kBlue);
+    CheckPixel(name, viewX + viewWidth - 1 - qx, viewY + viewHeight - 1 - qy, kWhite);
+    for (int y = 0; y < surfaceHeight; ++y) {
+        for (int x = 0; x < surfaceWidth; ++x) {
+            const bool inside = x >= viewX && x < viewX + viewWidth && y >= viewY &&
+                                y < viewY + viewHeight;
+            if (!inside) {
+                CheckPixel(name, x, y, kBlack);
+            }
+        }
+    }
+}
+
+static void TestInitPreviewGL() {
+    CHECK(InitPreviewGL());
+    CHECK(g_eglState.program != 0);
+    CHECK(g_eglState.tapProgram != 0);
+    CHECK(g_eglState.downProgram != 0);
+    CHECK(g_eglState.tapOffsetLoc >= 0);
+    CHECK(g_eglState.downOffsetLoc >= 0);
+    CHECK(g_eglState.vertexBuffer != 0);
+    CHECK(g_eglState.positionLoc == 0 && g_eglState.texCoordLoc == 1);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+static GLuint CurrentProgram() {
+    GLint program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    return static_cast<GLuint>(program);
+}
+
+// 表面 64x32，正方形画面缩放到 32x32 居中；按源尺寸分别落在三种缩小路径上
+static void TestDownscalePaths() {
+    CHECK(MakeHeadlessSurface(64, 32));
+    struct Case {
+        const char *name;
+        int size;
+        GLuint program;
+        bool twoPass;
+    };
+    const Case cases[] = {
+            {"bilinear", 64, g_eglState.program, false},
+            {"tap 2.5x", 80, g_eglState.tapProgram, false},
+            {"tap 4x", 128, g_eglState.tapProgram, false},
+            {"two-pass", 512, g_eglState.downProgram, true},
+    };
+    for (const Case &c : cases) {
+        AHardwareBuffer hb;
+        InitSourceBuffer(&hb, c.size, c.size, QuadrantPixels(c.size, c.size));
+        RenderPreview(&hb, 1);
+        CHECK_MSG(CurrentProgram() == c.program, "%s: wrong program", c.name);
+        if (c.twoPass) {
+            CHECK(g_eglState.fbo != 0);
+            CHECK(g_eglState.fboWidth == c.size / 4 && g_eglState.fboHeight == c.size / 4);
+        }
+        CheckLayout(c.name, 64, 32, 16, 0, 32, 32);
+        ReleaseImageCache();
+        glDeleteTextures(1, &hb.texture);
+    }
+}
+
+// 宽画面在高表面中上下留黑边；非整数缩放时视口取整后居中
+static void TestLetterbox() {
+    CHECK(MakeHeadlessSurface(64, 32));
+    AHardwareBuffer wide;
+    InitSourceBuffer(&wide, 128, 32, QuadrantPixels(128, 32));
+    RenderPreview(&wide, 1);
+    CheckLayout("letterbox", 64, 32, 0, 8, 64, 16);
+
+    CHECK(MakeHeadlessSurface(50, 40));
+    AHardwareBuffer tall;
+    InitSourceBuffer(&tall, 30, 60, QuadrantPixels(30, 60));
+    RenderPreview(&tall, 1);
+    CheckLayout("pillarbox", 50, 40, 15, 0, 20, 40);
+
+    ReleaseImageCache();
+    glDeleteTextures(1, &wide.texture);
+    glDeleteTextures(1, &tall.texture);
+}
+
+// 同一缓冲区只导入一次；超过容量时淘汰最久未用的一项；作废后下次绘制全部重新导入
+static void TestImageCache() {
+    CHECK(MakeHeadlessSurface(32, 32));
+    std::vector<AHardwareBuffer> buffers(kImageCacheSize + 1);
+    const std::vector<uint32_t> pixels = QuadrantPixels(16, 16);
+    for (AHardwareBuffer &hb : buffers) {
+        InitSourceBuffer(&hb, 16, 16, pixels);
+    }
+    PreviewStats before = {sizeof(PreviewStats)};
+    CHECK(GetPreviewStats(&before) == 0);
+    const int created = g_imagesCreated;
+    const int destroyed = g_imagesDestroyed;
+
+    RenderPreview(&buffers[0], 1);
+    RenderPreview(&buffers[0], 0);
+    CHECK(g_imagesCreated == created + 1);
+    for (int i = 1; i < kImageCacheSize; ++i) {
+        RenderPreview(&buffers[i], 1);
+    }
+    CHECK(g_imagesCreated == created + kImageCacheSize);
+    // buffers[1] 成为最久未用的一项
+    RenderPreview(&buffers[0], 1);
+    RenderPreview(&buffers[kImageCacheSize], 1);
+    CHECK(g_imagesCreated == created + kImageCacheSize + 1);
+    CHECK(g_imagesDestroyed == destroyed + 1);
+    RenderPreview(&buffers[0], 1);
+    CHECK(g_imagesCreated == created + kImageCacheSize + 1);
+    RenderPreview(&buffers[1], 1);
+    CHECK(g_imagesCreated == created + kImageCacheSize + 2);
+    CHECK(g_imagesDestroyed == destroyed + 2);
+
+    InvalidatePreviewImageCache();
+    RenderPreview(&buffers[0], 1);
+    CHECK(g_imagesDestroyed == destroyed + 2 + kImageCacheSize);
+    CHECK(g_imagesCreated == created + kImageCacheSize + 3);
+    CheckLayout("cache", 32, 32, 0, 0, 32, 32);
+
+    // 时间戳为 0 的重绘单独计数；缓存不持有缓冲区引用
+    PreviewStats after = {sizeof(PreviewStats)};
+    CHECK(GetPreviewStats(&after) == 0);
+    CHECK(after.redraws - before.redraws == 1);
+    CHECK(after.frames_rendered - before.frames_rendered == kImageCacheSize + 5);
+    for (AHardwareBuffer &hb : buffers) {
+        CHECK(hb.refs.load() == 0);
+    }
+
+    ReleaseImageCache();
+    CHECK(g_imagesCreated == g_imagesDestroyed);
+    for (AHardwareBuffer &hb : buffers) {
+        glDeleteTextures(1, &hb.texture);
+    }
+}
+
+int main() {
+    if (!InitHeadlessEGL(64, 32)) {
+        puts("preview_gl_test: skipped, headless EGL unavailable");
+        return kSkipReturnCode;
+    }
+    printf("preview_gl_test: %s\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+    TestInitPreviewGL();
+    TestDownscalePaths();
+    TestLetterbox();
+    TestImageCache();
+    DeinitEGL();
+    CHECK(!g_eglState.initialized && g_eglState.program == 0);
+    puts("preview_gl_test: OK");
+    return 0;
+}
@@ -0,0 +1,143 @@
+// 采集线程投递一帧的耗时分布：单槽原子信箱（DispatchPreview）对比原先互斥锁 + 条件变量队列。
+// 消费线程模拟渲染线程：取帧后绘制 kRenderUs 微秒，旧实现其中 kLockedUs 微秒的准备阶段持锁。
+// 绘制主要在等 GPU 和驱动，用睡眠模拟，单核机器上也不会因自旋互相抢占
+//   preview_mailbox_bench [投递次数]
+#include "bridge_preview.cpp"
+
+#include "preview_fakes.h"
+#include "test_util.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <queue>
+#include <vector>
+
+static constexpr int kBufferCount = 4;
+static constexpr int kRenderUs = 2000;
+static constexpr int kLockedUs = 300;
+// 投递间隔，远高于 60fps 以放大争用
+static constexpr int kDispatchGapUs = 100;
+
+static void SleepUs(int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+static void Report(const char *name, std::vector<int64_t> &samples) {
+    std::sort(samples.begin(), samples.end());
+    int64_t total = 0;
+    for (int64_t s : samples) {
+        total += s;
+    }
+    const size_t n = samples.size();
+    printf("%-16s %10.0f %10lld %10lld %10lld\n", name, static_cast<double>(total) / n,
+           static_cast<long long>(samples[n / 2]), static_cast<long long>(samples[n * 99 / 100]),
+           static_cast<long long>(samples[n - 1]));
+}
+
+template<typename Dispatch>
+static std::vector<int64_t> RunProducer(AHardwareBuffer *buffers, int count, Dispatch dispatch) {
+    std::vector<int64_t> samples(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const int64_t start = MonotonicNowNs();
+        dispatch(&buffers[i % kBufferCount], start);
+        samples[i] = MonotonicNowNs() - start;
+        SleepUs(kDispatchGapUs);
+    }
+    return samples;
+}
+
+// 单槽信箱：消费侧按渲染线程的方式等待 eventfd 并交换取帧
+static std::vector<int64_t> BenchMailbox(AHardwareBuffer *buffers, int count) {
+    g_renderEventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    CHECK(g_renderEventFd >= 0);
+    g_renderThreadRunning.store(true);
+    std::thread consumer([] {
+        while (g_renderThreadRunning.load(std::memory_order_acquire)) {
+            WaitRenderEvent(10);
+            AHardwareBuffer *hb = g_previewMailbox.exchange(nullptr, std::memory_order_acq_rel);
+            if (hb) {
+                SleepUs(kRenderUs);
+                AHardwareBuffer_release(hb);
+            }
+        }
+    });
+    std::vector<int64_t> samples = RunProducer(buffers, count, [](AHardwareBuffer *hb,
+                                                                  int64_t now) {
+        DispatchPreview(hb, now);
+    });
+    g_renderThreadRunning.store(false);
+    consumer.join();
+    DrainPreviewQueue();
+    close(g_renderEventFd);
+    g_renderEventFd = -1;
+    return samples;
+}
+
+// 原实现：std::queue + 互斥锁 + 条件变量，渲染线程在准备阶段持锁
+struct LockedQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::queue<AHardwareBuffer *> queue;
+    bool running = true;
+};
+
+static std::vector<int64_t> BenchLockedQueue(AHardwareBuffer *buffers, int count) {
+    LockedQueue q;
+    std::thread consumer([&q] {
+        std::unique_lock<std::mutex> lock(q.mutex);
+        while (q.running) {
+            q.cv.wait(lock, [&q] { return !q.queue.empty() || !q.running; });
+            if (q.queue.empty()) {
+                continue;
+            }
+            AHardwareBuffer *hb = q.queue.front();
+            q.queue.pop();
+            SleepUs(kLockedUs);
+            lock.unlock();
+            SleepUs(kRenderUs - kLockedUs);
+            AHardwareBuffer_release(hb);
+            lock.lock();
+        }
+    });
+    std::vector<int64_t> samples = RunProducer(buffers, count, [&q](AHardwareBuffer *hb,
+                                                                    int64_t now) {
+        AHardwareBuffer_acquire(hb);
+        std::lock_guard<std::mutex> lock(q.mutex);
+        while (!q.queue.empty()) {
+            AHardwareBuffer_release(q.queue.front());
+            q.queue.pop();
+        }
+        q.queue.push(hb);
+        q.cv.notify_one();
+    });
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.running = false;
+        while (!q.queue.empty()) {
+            AHardwareBuffer_release(q.queue.front());
+            q.queue.pop();
+        }
+    }
+    q.cv.notify_one();
+    consumer.join();
+    return samples;
+}
+
+int main(int argc, char **argv) {
+    const int count = argc > 1 ? std::max(100, atoi(argv[1])) : 10000;
+    AHardwareBuffer buffers[kBufferCount];
+    printf("%d dispatches every %dus, render %dus (%dus locked in the queue variant)\n", count,
+           kDispatchGapUs, kRenderUs, kLockedUs);
+    printf("%-16s %10s %10s %10s %10s\n", "ns per dispatch", "mean", "p50", "p99", "max");
+
+    std::vector<int64_t> mailbox = BenchMailbox(buffers, count);
+    Report("atomic mailbox", mailbox);
+    std::vector<int64_t> locked = BenchLockedQueue(buffers, count);
+    Report("mutex queue", locked);
+
+    for (AHardwareBuffer &hb : buffers) {
+        CHECK(hb.refs.load() == 0);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// 预览信箱的引用计数压力测试：采集线程不停投递帧，同时反复切换预览 Surface、可见性和缓存代数，
+// 结束后每个 AHardwareBuffer 的引用必须归零，窗口全部释放
+#include <EGL/egl.h>
+// 主机上没有窗口系统，让 InitEGL 失败走 CPU 回退；渲染线程照常启动并消费信箱
+#define eglGetDisplay(display) EGL_NO_DISPLAY
+#include "bridge_preview.cpp"
+
+#include "preview_fakes.h"
+#include "test_util.h"
+
+#include <chrono>
+
+static constexpr int kBufferCount = 4;
+static constexpr int kToggleRounds = 300;
+
+int main() {
+    _JNIEnv env;
+    _jobject surfaces[2];
+    AHardwareBuffer buffers[kBufferCount];
+    SetPreviewFrameRate(0);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> accepted{0};
+    std::thread producer([&] {
+        int64_t timestamp = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (DispatchPreview(&buffers[timestamp % kBufferCount], timestamp + 1)) {
+                accepted.fetch_add(1, std::memory_order_relaxed);
+            }
+            ++timestamp;
+        }
+    });
+
+    TestRandom rng(0x3A11B0Eu);
+    for (int i = 0; i < kToggleRounds; ++i) {
+        switch (rng.Range(0, 5)) {
+            case 0:
+                SetPreviewSurface(&env, nullptr);
+                break;
+            case 1:
+                SetPreviewVisible(false);
+                break;
+            case 2:
+                SetPreviewVisible(true);
+                break;
+            case 3:
+                InvalidatePreviewImageCache();
+                break;
+            default:
+                SetPreviewSurface(&env, &surfaces[i % 2]);
+                break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(rng.Range(0, 2000)));
+    }
+    SetPreviewVisible(true);
+    SetPreviewSurface(&env, nullptr);
+    stop.store(true);
+    producer.join();
+
+    PreviewStats stats = {sizeof(PreviewStats)};
+    CHECK(GetPreviewStats(&stats) == 0);
+    printf("preview_mailbox_test: accepted=%lld replaced=%lld backend_inits=%lld\n",
+           static_cast<long long>(accepted.load()), static_cast<long long>(stats.frames_replaced),
+           static_cast<long long>(stats.backend_inits));
+    CHECK(accepted.load() > 0);
+    CHECK(stats.frames_offered >= accepted.load());
+    CHECK(stats.backend_inits > 0);
+    CHECK(stats.backend == PREVIEW_BACKEND_NONE);
+
+    // 渲染线程已停止：投递被拒绝且不持有引用
+    CHECK(!DispatchPreview(&buffers[0], 1));
+    CHECK(g_previewMailbox.load() == nullptr);
+    for (int i = 0; i < kBufferCount; ++i) {
+        CHECK_MSG(buffers[i].refs.load() == 0, "buffer %d leaked %d refs", i,
+                  buffers[i].refs.load());
+    }
+    CHECK_MSG(g_fakeLiveWindows.load() == 0, "%d windows not released", g_fakeLiveWindows.load());
+    puts("preview_mailbox_test: OK");
+    return 0;
+}
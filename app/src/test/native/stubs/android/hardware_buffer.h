@@ -0,0 +1,61 @@
+#ifndef HOST_STUB_ANDROID_HARDWARE_BUFFER_H
+#define HOST_STUB_ANDROID_HARDWARE_BUFFER_H
+
+#include <cstdint>
+
+typedef struct AHardwareBuffer AHardwareBuffer;
+
+typedef struct ARect {
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+} ARect;
+
+typedef struct AHardwareBuffer_Desc {
+    uint32_t width;
+    uint32_t height;
+    uint32_t layers;
+    uint32_t format;
+    uint64_t usage;
+    uint32_t stride;
+    uint32_t rfu0;
+    uint64_t rfu1;
+} AHardwareBuffer_Desc;
+
+typedef struct AHardwareBuffer_Plane {
+    void *data;
+    uint32_t pixelStride;
+    uint32_t rowStride;
+} AHardwareBuffer_Plane;
+
+typedef struct AHardwareBuffer_Planes {
+    uint32_t planeCount;
+    AHardwareBuffer_Plane planes[4];
+} AHardwareBuffer_Planes;
+
+enum {
+    AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN = 3UL,
+    AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE = 1UL << 8,
+};
+
+enum {
+    AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM = 1,
+    AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM = 2,
+    AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM = 4,
+    AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420 = 0x23,
+};
+
+extern "C" {
+int AHardwareBuffer_lock(AHardwareBuffer *buffer, uint64_t usage, int32_t fence,
+                         const ARect *rect, void **address);
+int AHardwareBuffer_lockPlanes(AHardwareBuffer *buffer, uint64_t usage, int32_t fence,
+                               const ARect *rect, AHardwareBuffer_Planes *planes);
+int AHardwareBuffer_unlock(AHardwareBuffer *buffer, int32_t *fence);
+void AHardwareBuffer_describe(const AHardwareBuffer *buffer, AHardwareBuffer_Desc *desc);
+void AHardwareBuffer_acquire(AHardwareBuffer *buffer);
+void AHardwareBuffer_release(AHardwareBuffer *buffer);
+int AHardwareBuffer_getId(const AHardwareBuffer *buffer, uint64_t *id);
+}
+
+#endif // HOST_STUB_ANDROID_HARDWARE_BUFFER_H
@@ -0,0 +1,16 @@
+#ifndef HOST_STUB_ANDROID_LOG_H
+#define HOST_STUB_ANDROID_LOG_H
+
+// 主机测试用的 NDK 头文件替身，只声明 bridge 用到的部分
+
+enum {
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+};
+
+extern "C" int __android_log_print(int prio, const char *tag, const char *fmt, ...)
+        __attribute__((format(printf, 3, 4)));
+
+#endif // HOST_STUB_ANDROID_LOG_H
@@ -0,0 +1,35 @@
+#ifndef HOST_STUB_ANDROID_NATIVE_WINDOW_H
+#define HOST_STUB_ANDROID_NATIVE_WINDOW_H
+
+#include <android/hardware_buffer.h>
+
+#include <cstdint>
+
+typedef struct ANativeWindow ANativeWindow;
+
+typedef struct ANativeWindow_Buffer {
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t format;
+    void *bits;
+    uint32_t reserved[6];
+} ANativeWindow_Buffer;
+
+enum {
+    WINDOW_FORMAT_RGBA_8888 = 1,
+    WINDOW_FORMAT_RGBX_8888 = 2,
+    WINDOW_FORMAT_RGB_565 = 4,
+};
+
+extern "C" {
+void ANativeWindow_acquire(ANativeWindow *window);
+void ANativeWindow_release(ANativeWindow *window);
+int32_t ANativeWindow_setBuffersGeometry(ANativeWindow *window, int32_t width, int32_t height,
+                                         int32_t format);
+int32_t ANativeWindow_lock(ANativeWindow *window, ANativeWindow_Buffer *out_buffer,
+                           ARect *in_out_dirty_bounds);
+int32_t ANativeWindow_unlockAndPost(ANativeWindow *window);
+}
+
+#endif // HOST_STUB_ANDROID_NATIVE_WINDOW_H
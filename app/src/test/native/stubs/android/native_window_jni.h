@@ -0,0 +1,9 @@
+#ifndef HOST_STUB_ANDROID_NATIVE_WINDOW_JNI_H
+#define HOST_STUB_ANDROID_NATIVE_WINDOW_JNI_H
+
+#include <android/native_window.h>
+#include <jni.h>
+
+extern "C" ANativeWindow *ANativeWindow_fromSurface(JNIEnv *env, jobject surface);
+
+#endif // HOST_STUB_ANDROID_NATIVE_WINDOW_JNI_H
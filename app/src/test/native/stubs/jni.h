@@ -0,0 +1,29 @@
+#ifndef HOST_STUB_JNI_H
+#define HOST_STUB_JNI_H
+
+#include <cstdint>
+
+typedef uint8_t jboolean;
+typedef int32_t jint;
+typedef int64_t jlong;
+
+class _jobject {};
+class _jarray : public _jobject {};
+class _jlongArray : public _jarray {};
+
+typedef _jobject *jobject;
+typedef _jlongArray *jlongArray;
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+// 只保留预览用到的引用管理方法，由各测试按需实现
+struct _JNIEnv {
+    jobject NewGlobalRef(jobject obj);
+    void DeleteGlobalRef(jobject obj);
+    jboolean IsSameObject(jobject a, jobject b);
+};
+
+typedef _JNIEnv JNIEnv;
+
+#endif // HOST_STUB_JNI_H
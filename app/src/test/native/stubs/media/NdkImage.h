@@ -0,0 +1,34 @@
+#ifndef HOST_STUB_MEDIA_NDK_IMAGE_H
+#define HOST_STUB_MEDIA_NDK_IMAGE_H
+
+#include <android/hardware_buffer.h>
+#include <media/NdkMediaError.h>
+
+#include <cstdint>
+
+typedef struct AImage AImage;
+
+enum AIMAGE_FORMATS {
+    AIMAGE_FORMAT_RGBA_8888 = 1,
+    AIMAGE_FORMAT_RGBX_8888 = 2,
+    AIMAGE_FORMAT_RGB_565 = 4,
+    AIMAGE_FORMAT_YUV_420_888 = 0x23,
+};
+
+extern "C" {
+void AImage_delete(AImage *image);
+void AImage_deleteAsync(AImage *image, int release_fence_fd);
+media_status_t AImage_getHardwareBuffer(const AImage *image, AHardwareBuffer **buffer);
+media_status_t AImage_getTimestamp(const AImage *image, int64_t *timestamp_ns);
+media_status_t AImage_getWidth(const AImage *image, int32_t *width);
+media_status_t AImage_getHeight(const AImage *image, int32_t *height);
+media_status_t AImage_getFormat(const AImage *image, int32_t *format);
+media_status_t AImage_getNumberOfPlanes(const AImage *image, int32_t *num_planes);
+media_status_t AImage_getPlanePixelStride(const AImage *image, int plane_idx,
+                                          int32_t *pixel_stride);
+media_status_t AImage_getPlaneRowStride(const AImage *image, int plane_idx, int32_t *row_stride);
+media_status_t AImage_getPlaneData(const AImage *image, int plane_idx, uint8_t **data,
+                                   int *data_length);
+}
+
+#endif // HOST_STUB_MEDIA_NDK_IMAGE_H
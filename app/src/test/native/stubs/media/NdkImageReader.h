@@ -0,0 +1,9 @@
+#ifndef HOST_STUB_MEDIA_NDK_IMAGE_READER_H
+#define HOST_STUB_MEDIA_NDK_IMAGE_READER_H
+
+#include <android/native_window.h>
+#include <media/NdkImage.h>
+
+typedef struct AImageReader AImageReader;
+
+#endif // HOST_STUB_MEDIA_NDK_IMAGE_READER_H
@@ -0,0 +1,11 @@
+#ifndef HOST_STUB_MEDIA_NDK_MEDIA_ERROR_H
+#define HOST_STUB_MEDIA_NDK_MEDIA_ERROR_H
+
+typedef enum {
+    AMEDIA_OK = 0,
+    AMEDIA_ERROR_UNKNOWN = -10000,
+    AMEDIA_IMGREADER_NO_BUFFER_AVAILABLE = -30000,
+    AMEDIA_IMGREADER_MAX_IMAGES_ACQUIRED = -30001,
+} media_status_t;
+
+#endif // HOST_STUB_MEDIA_NDK_MEDIA_ERROR_H
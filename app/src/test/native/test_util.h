@@ -0,0 +1,52 @@
+#ifndef BRIDGE_TEST_UTIL_H
+#define BRIDGE_TEST_UTIL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// 不依赖测试框架，失败时打印位置并以非零退出，由 ctest 判定
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                                  \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_MSG(cond, ...)                                                          \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            fprintf(stderr, "%s:%d: CHECK failed: %s: ", __FILE__, __LINE__, #cond); \
+            fprintf(stderr, __VA_ARGS__);                                             \
+            fputc('\n', stderr);                                                      \
+            exit(1);                                                                  \
+        }                                                                             \
+    } while (0)
+
+// 固定种子的 xorshift，保证失败可复现
+struct TestRandom {
+    uint32_t state;
+
+    explicit TestRandom(uint32_t seed) : state(seed ? seed : 1) {}
+
+    uint32_t Next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    int Range(int lo, int hi) {
+        return lo + static_cast<int>(Next() % static_cast<uint32_t>(hi - lo + 1));
+    }
+
+    void Fill(std::vector<uint8_t> &bytes) {
+        for (uint8_t &b : bytes) {
+            b = static_cast<uint8_t>(Next() >> 24);
+        }
+    }
+};
+
+#endif // BRIDGE_TEST_UTIL_H